@@ -48,15 +48,17 @@ void BitMask::resize(size_t bits) {
     _size = bits;
 }
 
-size_t BitMask::findSet(size_t start) const
+namespace impl {
+PVXS_API
+size_t findSet(const uint64_t* words, size_t nbits, size_t start)
 {
-    while(start < _size) {
+    while(start < nbits) {
         size_t word = start/64u,
                 bit = start%64u;
 
         // first see if we can skip to next word
         uint64_t mask = ~((1ull<<bit)-1); // mask of bit and higher
-        uint64_t masked = _words[word]&mask;
+        uint64_t masked = words[word]&mask;
         if(masked==0u) {
             start = (word+1u)*64u;
             continue;
@@ -64,6 +66,9 @@ size_t BitMask::findSet(size_t start) const
 
         // the answer is in range [bit, 64)
 
+#if defined(__GNUC__)
+        return (word*64u) | unsigned(__builtin_ctzll(masked));
+#else
         // count consecutive "trailing" zeros.
         // http://graphics.stanford.edu/~seander/bithacks.html#ZerosOnRightParallel
 
@@ -82,9 +87,16 @@ size_t BitMask::findSet(size_t start) const
         if(masked&0x5555555555555555ull) bit -= 1u; // 0xb0101 repeated
 
         return (word*64u) | bit;
+#endif
     }
 
-    return _size;
+    return nbits;
+}
+} // namespace impl
+
+size_t BitMask::findSet(size_t start) const
+{
+    return impl::findSet(_words.data(), _size, start);
 }
 
 std::ostream& operator<<(std::ostream& strm, const BitMask& mask)
@@ -114,12 +126,17 @@ namespace impl {
 
 PVXS_API
 void to_wire(Buffer& buf, const BitMask& mask)
+{
+    to_wire(buf, mask.wsize() ? &mask.word(0) : nullptr, mask.wsize());
+}
+
+PVXS_API
+void to_wire(Buffer& buf, const uint64_t* words, size_t nwords)
 {
     // ignore trailing zeros
-    size_t nwords=mask.wsize();
     size_t extra = 0u;
     while(nwords) {
-        auto last = mask.word(nwords-1u);
+        auto last = words[nwords-1u];
         if(last&0xff00000000000000ull) break;
         nwords--;
         if(last==0) continue;
@@ -136,10 +153,10 @@ void to_wire(Buffer& buf, const BitMask& mask)
 
     to_wire(buf, Size{nbytes});
     for(auto i : range(nwords)) {
-        to_wire(buf, mask.word(i));
+        to_wire(buf, words[i]);
     }
     if(extra) {
-        uint64_t last = mask.word(nwords);
+        uint64_t last = words[nwords];
         for(auto i : range(extra)) {
             to_wire(buf, uint8_t(last>>(8u*i)));
         }
@@ -52,17 +52,27 @@ Connected::Connected(const std::string& peerName)
 
 Connected::~Connected() {}
 
-Channel::Channel(const std::shared_ptr<Context::Pvt>& context, const std::string& name, uint32_t cid)
+TCPWorker::TCPWorker(uint32_t index, uint32_t step)
+    :index(index)
+    ,step(step)
+    ,nextCID(index)
+    ,loop(SB()<<"PVXCTCP"<<index, epicsThreadPriorityCAServerLow)
+{}
+
+Channel::Channel(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const std::string& name, uint32_t cid)
     :context(context)
+    ,worker(worker)
     ,name(name)
     ,cid(cid)
 {}
 
 Channel::~Channel()
 {
-    context->chanByCID.erase(cid);
-    context->chanByName.erase(name);
+    worker.chanByCID.erase(cid);
+    worker.chanByName.erase(name);
     // searchBuckets cleaned in tickSearch()
+    if(state==Searching)
+        context->stopSearch(std::vector<uint32_t>{cid});
     if((state==Creating || state==Active) && conn && conn->bev) {
         {
             (void)evbuffer_drain(conn->txBody.get(), evbuffer_get_length(conn->txBody.get()));
@@ -109,7 +119,7 @@ void Channel::disconnect(const std::shared_ptr<Channel>& self)
 {
     self->state = Channel::Searching;
     self->sid = 0xdeadbeef; // spoil
-    context->searchBuckets[context->currentBucket].push_back(self);
+    context->startSearch(*self);
 
     log_debug_printf(io, "Server %s detach channel '%s' to re-search\n",
                      conn ? conn->peerName.c_str() : "<disconnected>",
@@ -120,10 +130,31 @@ void Channel::disconnect(const std::shared_ptr<Channel>& self)
 OperationBase::OperationBase(operation_t op, const std::shared_ptr<Channel>& chan)
     :Operation(op)
     ,chan(chan)
+    ,executor([&chan]() -> evbase* {
+        auto& pool = chan->context->callbackWorkers;
+        if(pool.empty())
+            return nullptr;
+        return pool[chan->context->nextCallbackWorker++ % pool.size()].get();
+    }())
 {}
 
 OperationBase::~OperationBase() {}
 
+void OperationBase::callback(std::function<void()>&& fn)
+{
+    if(executor)
+        executor->dispatch(std::move(fn));
+    else
+        fn();
+}
+
+void OperationBase::syncCallbacks(evbase& loop)
+{
+    // the executor may itself be waiting for the worker loop
+    if(executor && !loop.inLoop())
+        executor->sync();
+}
+
 RequestInfo::RequestInfo(uint32_t sid, uint32_t ioid, std::shared_ptr<OperationBase>& handle)
     :sid(sid)
     ,ioid(ioid)
@@ -131,25 +162,26 @@ RequestInfo::RequestInfo(uint32_t sid, uint32_t ioid, std::shared_ptr<OperationB
     ,handle(handle)
 {}
 
-std::shared_ptr<Channel> Channel::build(const std::shared_ptr<Context::Pvt>& context, const std::string& name)
+std::shared_ptr<Channel> Channel::build(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const std::string& name)
 {
+    worker.loop.assertInLoop();
 
     std::shared_ptr<Channel> chan;
 
-    auto it = context->chanByName.find(name);
-    if(it!=context->chanByName.end()) {
+    auto it = worker.chanByName.find(name);
+    if(it!=worker.chanByName.end()) {
         chan = it->second.lock();
     }
 
     if(!chan) {
-        while(context->chanByCID.find(context->nextCID)!=context->chanByCID.end())
-            context->nextCID++;
+        while(worker.chanByCID.find(worker.nextCID)!=worker.chanByCID.end())
+            worker.advanceCID();
 
-        chan = std::make_shared<Channel>(context, name, context->nextCID);
-        context->chanByCID[chan->cid] = chan;
-        context->chanByName[chan->name] = chan;
+        chan = std::make_shared<Channel>(context, worker, name, worker.nextCID);
+        worker.chanByCID[chan->cid] = chan;
+        worker.chanByName[chan->name] = chan;
 
-        context->searchBuckets[context->currentBucket].push_back(chan);
+        context->startSearch(*chan);
     }
 
     return chan;
@@ -219,14 +251,24 @@ Context::Pvt::Pvt(const Config& conf)
     :effective(conf)
     ,caMethod(buildCAMethod())
     ,searchTx(AF_INET, SOCK_DGRAM, 0)
-    ,tcp_loop("PVXCTCP", epicsThreadPriorityCAServerLow)
-    ,searchRx(event_new(tcp_loop.base, searchTx.sock, EV_READ|EV_PERSIST, &Pvt::onSearchS, this))
-    ,searchTimer(event_new(tcp_loop.base, -1, EV_TIMEOUT, &Pvt::tickSearchS, this))
+    ,search_loop("PVXCSRCH", epicsThreadPriorityCAServerLow)
+    ,searchRx(event_new(search_loop.base, searchTx.sock, EV_READ|EV_PERSIST, &Pvt::onSearchS, this))
+    ,searchTimer(event_new(search_loop.base, -1, EV_TIMEOUT, &Pvt::tickSearchS, this))
     ,manager(UDPManager::instance())
     ,beaconCleaner(event_new(manager.loop().base, -1, EV_TIMEOUT, &Pvt::tickBeaconCleanS, this))
 {
     effective.expand();
 
+    workers.reserve(effective.tcp_workers);
+    for(auto i : range(effective.tcp_workers)) {
+        workers.emplace_back(new TCPWorker(i, effective.tcp_workers));
+    }
+
+    callbackWorkers.reserve(effective.callback_workers);
+    for(auto i : range(effective.callback_workers)) {
+        callbackWorkers.emplace_back(new evbase(SB()<<"PVXCCB"<<i, epicsThreadPriorityCAServerLow-1));
+    }
+
     searchBuckets.resize(nBuckets);
 
     std::set<std::string> bcasts;
@@ -307,21 +349,30 @@ Context::Pvt::~Pvt() {}
 
 void Context::Pvt::close()
 {
-    // terminate all active connections
-    tcp_loop.call([this]() {
+    search_loop.call([this]() {
         (void)event_del(searchTimer.get());
         (void)event_del(searchRx.get());
+    });
 
-        decltype (connByAddr) conns(std::move(connByAddr));
+    // terminate all active connections
+    for(auto& worker : workers) {
+        worker->loop.call([&worker]() {
+            decltype (worker->connByAddr) conns(std::move(worker->connByAddr));
 
-        for(auto& pair : conns) {
-            auto conn = pair.second.lock();
-            if(!conn)
-                continue;
+            for(auto& pair : conns) {
+                auto conn = pair.second.lock();
+                if(!conn)
+                    continue;
 
-            conn->cleanup();
-        }
-    });
+                conn->cleanup();
+            }
+        });
+    }
+
+    // wait for queued callbacks, including final disconnect events
+    for(auto& worker : callbackWorkers) {
+        worker->sync();
+    }
 }
 
 void Context::Pvt::poke()
@@ -342,6 +393,77 @@ void Context::Pvt::poke()
         throw std::runtime_error("Unable to schedule searchTimer");
 }
 
+TCPWorker& Context::Pvt::workerFor(const std::string& name)
+{
+    return *workers[std::hash<std::string>()(name) % workers.size()];
+}
+
+void Context::Pvt::startSearch(const Channel& chan)
+{
+    auto cid = chan.cid;
+    auto name = chan.name;
+    search_loop.dispatch([this, cid, name]() {
+        if(searchByCID.emplace(cid, Searching(name)).second)
+            searchBuckets[currentBucket].push_back(cid);
+    });
+}
+
+void Context::Pvt::stopSearch(std::vector<uint32_t>&& cids)
+{
+    // searchBuckets cleaned in tickSearch()
+    auto todo(std::make_shared<std::vector<uint32_t>>(std::move(cids)));
+    search_loop.dispatch([this, todo]() {
+        for(auto cid : *todo)
+            searchByCID.erase(cid);
+    });
+}
+
+void Context::Pvt::onFound(TCPWorker& worker, const std::array<uint8_t, 12>& guid, const SockAddr& serv, const std::vector<uint32_t>& cids)
+{
+    std::vector<uint32_t> found;
+
+    for(auto id : cids) {
+        std::shared_ptr<Channel> chan;
+        {
+            auto it = worker.chanByCID.find(id);
+            if(it==worker.chanByCID.end())
+                continue;
+
+            chan = it->second.lock();
+            if(!chan)
+                continue;
+        }
+
+        log_debug_printf(io, "Search reply for %s\n", chan->name.c_str());
+
+        if(chan->state==Channel::Searching) {
+            chan->guid = guid;
+            chan->replyAddr = serv;
+
+            auto it = worker.connByAddr.find(serv);
+            if(it==worker.connByAddr.end() || !(chan->conn = it->second.lock())) {
+                worker.connByAddr[serv] = chan->conn = std::make_shared<Connection>(internal_self.lock(), worker, serv);
+            }
+
+            chan->conn->pending.push_back(chan);
+            chan->state = Channel::Connecting;
+
+            chan->conn->createChannels();
+
+            found.push_back(id);
+
+        } else if(chan->guid!=guid) {
+            log_err_printf(duppv, "Duplicate PV name %s from %s and %s\n",
+                           chan->name.c_str(),
+                           chan->replyAddr.tostring().c_str(),
+                           serv.tostring().c_str());
+        }
+    }
+
+    if(!found.empty())
+        stopSearch(std::move(found));
+}
+
 void Context::Pvt::onBeacon(const UDPManager::Beacon& msg)
 {
     const auto& guid = msg.guid;
@@ -367,11 +489,15 @@ void Context::Pvt::onBeacon(const UDPManager::Beacon& msg)
 
 bool Context::Pvt::onSearch()
 {
-    searchMsg.resize(0x10000);
-    SockAddr src;
+    constexpr size_t nBatch = 8u, bufSize = 0x10000;
+    searchRxBuf.resize(nBatch*bufSize);
+    searchRxMsgs.resize(nBatch);
+    for(auto i : range(nBatch)) {
+        searchRxMsgs[i].buf = &searchRxBuf[i*bufSize];
+        searchRxMsgs[i].len = bufSize-1u;
+    }
 
-    osiSocklen_t alen = src.size();
-    const int nrx = recvfrom(searchTx.sock, (char*)&searchMsg[0], searchMsg.size()-1, 0, &src->sa, &alen);
+    const int nrx = searchTx.recvmmsg(searchRxMsgs.data(), searchRxMsgs.size());
 
     if(nrx<0) {
         int err = evutil_socket_geterror(searchTx.sock);
@@ -382,30 +508,42 @@ bool Context::Pvt::onSearch()
                        evutil_socket_error_to_string(err));
         }
         return false; // wait for more I/O
+    }
+
+    for(auto i : range(nrx)) {
+        auto& msg = searchRxMsgs[i];
+        onSearchReply(static_cast<uint8_t*>(msg.buf), int(msg.len), msg.addr);
+    }
 
-    } else if(nrx<8) {
+    // a partial batch means the socket has been drained
+    return size_t(nrx)==searchRxMsgs.size();
+}
+
+void Context::Pvt::onSearchReply(uint8_t* buf, const int nrx, const SockAddr& src)
+{
+    if(nrx<8) {
         // maybe a zero (body) length packet?
         // maybe an OS error?
 
         log_info_printf(io, "UDP ignore runt%s\n", "");
-        return true;
+        return;
 
-    } else if(searchMsg[0]!=0xca || searchMsg[1]==0 || (searchMsg[2]&(pva_flags::Control|pva_flags::SegMask))) {
+    } else if(buf[0]!=0xca || buf[1]==0 || (buf[2]&(pva_flags::Control|pva_flags::SegMask))) {
         // minimum header size is 8 bytes
         // ID byte must by 0xCA (because PVA has some paternal envy)
         // ignore incompatible version 0
         // UDP packets can't contain control messages, or use segmentation
 
         log_info_printf(io, "UDP ignore header%u %02x%02x%02x%02x\n",
-                   unsigned(nrx), searchMsg[0], searchMsg[1], searchMsg[2], searchMsg[3]);
-        return true;
+                   unsigned(nrx), buf[0], buf[1], buf[2], buf[3]);
+        return;
     }
 
-    log_hex_printf(io, Level::Debug, &searchMsg[0], nrx, "UDP search Rx %d from %s\n", nrx, src.tostring().c_str());
+    log_hex_printf(io, Level::Debug, buf, nrx, "UDP search Rx %d from %s\n", nrx, src.tostring().c_str());
 
-    bool be = searchMsg[2]&pva_flags::MSB;
+    bool be = buf[2]&pva_flags::MSB;
 
-    FixedBuf M(be, searchMsg.data(), nrx);
+    FixedBuf M(be, buf, nrx);
 
     const uint8_t cmd = M[3];
     M.skip(4);
@@ -416,7 +554,7 @@ bool Context::Pvt::onSearch()
     if(len > M.size() && M.good()) {
         log_info_printf(io, "UDP ignore header%u %02x%02x%02x%02x\n",
                    unsigned(M.size()), M[0], M[1], M[2], M[3]);
-        return true;
+        return;
     }
 
     if(cmd==CMD_SEARCH_RESPONSE) {
@@ -437,16 +575,19 @@ bool Context::Pvt::onSearch()
         serv.setPort(port);
 
         if(M.size()<4u || M[0]!=3u || M[1]!='t' || M[2]!='c' || M[3]!='p')
-            return true;
+            return;
         M.skip(4u);
 
         from_wire(M, found);
         if(!found)
-            return true;
+            return;
 
         uint16_t nSearch = 0u;
         from_wire(M, nSearch);
 
+        // CIDs are allocated such that the owning worker is implied
+        std::vector<std::vector<uint32_t>> byWorker(workers.size());
+
         for(auto n : range(nSearch)) {
             (void)n;
 
@@ -455,39 +596,18 @@ bool Context::Pvt::onSearch()
             if(!M.good())
                 break;
 
-            std::shared_ptr<Channel> chan;
-            {
-                auto it = chanByCID.find(id);
-                if(it==chanByCID.end())
-                    continue;
-
-                chan = it->second.lock();
-                if(!chan)
-                    continue;
-            }
-
-            log_debug_printf(io, "Search reply for %s\n", chan->name.c_str());
-
-            if(chan->state==Channel::Searching) {
-                chan->guid = guid;
-                chan->replyAddr = serv;
-
-                auto it = connByAddr.find(serv);
-                if(it==connByAddr.end() || !(chan->conn = it->second.lock())) {
-                    connByAddr[serv] = chan->conn = std::make_shared<Connection>(internal_self.lock(), serv);
-                }
-
-                chan->conn->pending.push_back(chan);
-                chan->state = Channel::Connecting;
+            byWorker[id % workers.size()].push_back(id);
+        }
 
-                chan->conn->createChannels();
+        for(auto i : range(workers.size())) {
+            if(byWorker[i].empty())
+                continue;
 
-            } else if(chan->guid!=guid) {
-                log_err_printf(duppv, "Duplicate PV name %s from %s and %s\n",
-                               chan->name.c_str(),
-                               chan->replyAddr.tostring().c_str(),
-                               serv.tostring().c_str());
-            }
+            auto worker = workers[i].get();
+            auto cids(std::make_shared<std::vector<uint32_t>>(std::move(byWorker[i])));
+            worker->loop.dispatch([this, worker, guid, serv, cids]() {
+                onFound(*worker, guid, serv, *cids);
+            });
         }
 
     } else {
@@ -495,10 +615,8 @@ bool Context::Pvt::onSearch()
     }
 
     if(!M.good()) {
-        log_hex_printf(io, Level::Err, &searchMsg[0], nrx, "Invalid search reply %d from %s\n", nrx, src.tostring().c_str());
+        log_hex_printf(io, Level::Err, buf, nrx, "Invalid search reply %d from %s\n", nrx, src.tostring().c_str());
     }
-
-    return true;
 }
 
 void Context::Pvt::onSearchS(evutil_socket_t fd, short evt, void *raw)
@@ -508,7 +626,7 @@ void Context::Pvt::onSearchS(evutil_socket_t fd, short evt, void *raw)
         if(!(evt&EV_READ))
             return;
 
-        // handle up to 4 packets before going back to the reactor
+        // handle up to 4 batches before going back to the reactor
         for(unsigned i=0; i<4 && static_cast<Pvt*>(raw)->onSearch(); i++) {}
 
     }catch(std::exception& e){
@@ -558,20 +676,21 @@ void Context::Pvt::tickSearch()
 
         bool payload = false;
         while(!bucket.empty()) {
-            auto chan = bucket.front().lock();
-            if(!chan || chan->state!=Channel::Searching) {
+            auto it = searchByCID.find(bucket.front());
+            if(it==searchByCID.end()) {
                 bucket.pop_front();
                 continue;
             }
+            auto& search = it->second;
 
-            if(searchMsg.size()<=maxSearchPayload-(5+chan->name.size()))
+            if(searchMsg.size()<=maxSearchPayload-(5+search.name.size()))
                 break;
 
-            to_wire(M, uint32_t(chan->cid));
-            to_wire(M, chan->name);
+            to_wire(M, uint32_t(it->first));
+            to_wire(M, search.name);
             count++;
 
-            auto ninc = chan->nSearch = std::min(searchBuckets.size(), chan->nSearch+1u);
+            auto ninc = search.nSearch = std::min(searchBuckets.size(), search.nSearch+1u);
             auto next = (idx + ninc)%searchBuckets.size();
             auto nextnext = (next + 1u)%searchBuckets.size();
 
@@ -604,11 +723,21 @@ void Context::Pvt::tickSearch()
             FixedBuf H(true, searchMsg.data(), 8);
             to_wire(H, Header{CMD_SEARCH, pva_flags::Server, uint32_t(consumed-8u)});
         }
-        for(auto& pair : searchDest) {
-            // TODO: unicast/bcast
-            *pflags = pair.second ? 0x80 : 0x00;
+        // unicast and broadcast variants differ only in flags
+        searchMsgBcast.assign(searchMsg.begin(), searchMsg.begin()+consumed);
+        *pflags = 0x80;
+        searchMsgBcast[pflags - searchMsg.data()] = 0x00;
+
+        searchTxMsgs.resize(searchDest.size());
+        for(auto i : range(searchDest.size())) {
+            auto& pair = searchDest[i];
+            searchTxMsgs[i].addr = pair.first;
+            searchTxMsgs[i].buf = pair.second ? searchMsg.data() : searchMsgBcast.data();
+            searchTxMsgs[i].len = consumed;
+        }
 
-            int ntx = sendto(searchTx.sock, (char*)searchMsg.data(), consumed, 0, &pair.first->sa, pair.first.size());
+        for(size_t i=0; i<searchTxMsgs.size(); ) {
+            int ntx = searchTx.sendmmsg(&searchTxMsgs[i], searchTxMsgs.size()-i);
 
             if(ntx<0) {
                 int err = evutil_socket_geterror(searchTx.sock);
@@ -617,14 +746,13 @@ void Context::Pvt::tickSearch()
                     lvl = Level::Debug;
                 log_printf(io, lvl, "Search tx error (%d) %s\n",
                            err, evutil_socket_error_to_string(err));
-
-            } else if(unsigned(ntx)<consumed) {
-                log_warn_printf(io, "Search truncated %u < %u",
-                           unsigned(ntx), unsigned(consumed));
+                i++; // skip this destination
 
             } else {
-                log_debug_printf(io, "Search to %s %s\n", pair.first.tostring().c_str(),
-                                 pair.second ? "ucast" : "bcast");
+                for(auto end = i+size_t(ntx); i<end; i++) {
+                    log_debug_printf(io, "Search to %s %s\n", searchDest[i].first.tostring().c_str(),
+                                     searchDest[i].second ? "ucast" : "bcast");
+                }
             }
         }
     }
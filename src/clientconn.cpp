@@ -14,12 +14,13 @@ namespace client {
 
 DEFINE_LOGGER(io, "pvxs.client.io");
 
-Connection::Connection(const std::shared_ptr<Context::Pvt>& context, const SockAddr& peerAddr)
+Connection::Connection(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const SockAddr& peerAddr)
     :ConnBase (true,
-               bufferevent_socket_new(context->tcp_loop.base, -1, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
+               bufferevent_socket_new(worker.loop.base, -1, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
                peerAddr)
     ,context(context)
-    ,echoTimer(event_new(context->tcp_loop.base, -1, EV_TIMEOUT|EV_PERSIST, &tickEchoS, this))
+    ,worker(worker)
+    ,echoTimer(event_new(worker.loop.base, -1, EV_TIMEOUT|EV_PERSIST, &tickEchoS, this))
 {
     bufferevent_setcb(bev.get(), &bevReadS, nullptr, &bevEventS, this);
 
@@ -116,7 +117,7 @@ void Connection::cleanup()
     // (maybe) keep myself alive
     std::shared_ptr<Connection> self;
 
-    context->connByAddr.erase(peerAddr);
+    worker.connByAddr.erase(peerAddr);
 
     if(bev)
         bev.reset();
@@ -320,7 +321,7 @@ void Connection::handle_CREATE_CHANNEL()
         // server refuses to create a channel, but presumably responded positivly to search
 
         chan->state = Channel::Searching;
-        context->searchBuckets[context->currentBucket].push_back(chan);
+        context->startSearch(*chan);
 
         log_warn_printf(io, "Server %s refuses channel to '%s' : %s\n", peerName.c_str(),
                         chan->name.c_str(), sts.msg.c_str());
@@ -370,11 +371,13 @@ void Connection::handle_DESTROY_CHANNEL()
     chan->state = Channel::Searching;
     chan->sid = 0xdeadbeef; // spoil
     self = std::move(chan->conn);
-    context->searchBuckets[context->currentBucket].push_back(chan);
+    context->startSearch(*chan);
 
     for(auto& pair : chan->opByIOID) {
         auto op = pair.second->handle.lock();
         opByIOID.erase(pair.first); // invalidates pair.second
+        if(!op)
+            continue; // cancel() in progress on another thread
         op->disconnected(op);
     }
 
@@ -43,6 +43,22 @@ struct GPROp : public OperationBase
     }
 
     void notify() {
+        if(executor && done) {
+            // done is only called once, so may be moved
+            auto cb(std::move(done));
+            auto res(std::make_shared<Result>(std::move(result)));
+            auto name(chan->name);
+            executor->dispatch([cb, res, name]() {
+                try {
+                    cb(std::move(*res));
+                } catch(std::exception& e) {
+                    log_err_printf(io, "Channel %s error in result cb : %s\n",
+                                   name.c_str(), e.what());
+                }
+            });
+            return;
+        }
+
         try {
             if(done)
                 done(std::move(result));
@@ -60,8 +76,9 @@ struct GPROp : public OperationBase
     virtual void cancel() override final
     {
         auto context = chan->context;
+        auto& loop = chan->worker.loop;
         decltype (done) junk;
-        context->tcp_loop.call([this, &junk](){
+        loop.call([this, &junk](){
             if(state==GetOPut || state==Exec) {
                 chan->conn->sendDestroyRequest(chan->sid, ioid);
 
@@ -74,6 +91,7 @@ struct GPROp : public OperationBase
             junk = std::move(done);
             // leave opByIOID for GC
         });
+        syncCallbacks(loop);
     }
 
     virtual void createOp() override final
@@ -92,7 +110,7 @@ struct GPROp : public OperationBase
             to_wire(R, chan->sid);
             to_wire(R, ioid);
             to_wire(R, uint8_t(0x08)); // INIT
-            to_wire(R, Value::Helper::desc(pvRequest));
+            to_wire(R, Value::Helper::type(pvRequest), conn->txRegistry);
             to_wire_full(R, pvRequest);
         }
         conn->enqueueTxBody(pva_app_msg_t(uint8_t(op)));
@@ -344,8 +362,9 @@ std::shared_ptr<Operation> GetBuilder::_exec_get()
     std::shared_ptr<Operation> ret;
     assert(_get);
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx, _name);
+    auto& worker = ctx->workerFor(_name);
+    worker.loop.call([&ret, &worker, this]() {
+        auto chan = Channel::build(ctx, worker, _name);
 
         auto op = std::make_shared<GPROp>(Operation::Get, chan);
         op->done = std::move(_result);
@@ -367,8 +386,9 @@ std::shared_ptr<Operation> PutBuilder::exec()
     if(!_builder)
         throw std::logic_error("put() requires a builder()");
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx, _name);
+    auto& worker = ctx->workerFor(_name);
+    worker.loop.call([&ret, &worker, this]() {
+        auto chan = Channel::build(ctx, worker, _name);
 
         auto op = std::make_shared<GPROp>(Operation::Put, chan);
         op->done = std::move(_result);
@@ -389,8 +409,9 @@ std::shared_ptr<Operation> RPCBuilder::exec()
 {
     std::shared_ptr<Operation> ret;
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx, _name);
+    auto& worker = ctx->workerFor(_name);
+    worker.loop.call([&ret, &worker, this]() {
+        auto chan = Channel::build(ctx, worker, _name);
 
         auto op = std::make_shared<GPROp>(Operation::RPC, chan);
         op->done = std::move(_result);
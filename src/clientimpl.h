@@ -7,6 +7,8 @@
 #define CLIENTIMPL_H
 
 #include <list>
+#include <limits>
+#include <atomic>
 
 #include <epicsTime.h>
 
@@ -22,16 +24,50 @@ namespace pvxs {
 namespace client {
 
 struct Channel;
+struct Connection;
+
+// A share of the Channels, and their Connections, of a Context.
+// All state is only accessed from the worker loop.
+struct TCPWorker {
+    const uint32_t index, step;
+
+    // CIDs allocated by this worker are congruent to index modulo step
+    uint32_t nextCID;
+
+    std::map<uint32_t, std::weak_ptr<Channel>> chanByCID;
+    std::map<std::string, std::weak_ptr<Channel>> chanByName;
+
+    std::map<SockAddr, std::weak_ptr<Connection>> connByAddr;
+
+    evbase loop;
+
+    TCPWorker(uint32_t index, uint32_t step);
+
+    inline void advanceCID() {
+        if(nextCID > std::numeric_limits<uint32_t>::max() - step)
+            nextCID = index;
+        else
+            nextCID += step;
+    }
+};
 
 // internal actions on an Operation
-struct OperationBase : public Operation
+struct OperationBase : public Operation, public std::enable_shared_from_this<OperationBase>
 {
     std::shared_ptr<Channel> chan;
     uint32_t ioid;
 
+    // runs user callbacks for this operation, in order.  NULL when Config::callback_workers==0
+    evbase* const executor;
+
     OperationBase(operation_t op, const std::shared_ptr<Channel>& chan);
     virtual ~OperationBase();
 
+    // Run a user callback on our executor, if any, otherwise now.
+    void callback(std::function<void()>&& fn);
+    // From cancel().  Wait for callbacks already queued to our executor.
+    void syncCallbacks(evbase& loop);
+
     virtual void createOp() =0;
     virtual void disconnected(const std::shared_ptr<OperationBase>& self) =0;
 };
@@ -48,6 +84,7 @@ struct RequestInfo {
 
 struct Connection : public ConnBase, public std::enable_shared_from_this<Connection> {
     const std::shared_ptr<Context::Pvt> context;
+    TCPWorker& worker;
 
     const evevent echoTimer;
 
@@ -64,7 +101,7 @@ struct Connection : public ConnBase, public std::enable_shared_from_this<Connect
 
     uint32_t nextIOID = 0u;
 
-    Connection(const std::shared_ptr<Context::Pvt>& context, const SockAddr &peerAddr);
+    Connection(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const SockAddr &peerAddr);
     virtual ~Connection();
 
     void createChannels();
@@ -99,6 +136,8 @@ protected:
 
 struct Channel {
     const std::shared_ptr<Context::Pvt> context;
+    // Channel, its operations, and its Connection are only accessed from worker.loop
+    TCPWorker& worker;
     const std::string name;
     // Our choosen ID for this channel.
     // used as persistent CID and searchID
@@ -114,9 +153,6 @@ struct Channel {
     std::shared_ptr<Connection> conn;
     uint32_t sid = 0u;
 
-    // when state==Searching, number of repeatitions
-    size_t nSearch = 0u;
-
     // GUID of last positive reply when state!=Searching
     std::array<uint8_t, 12> guid;
     SockAddr replyAddr;
@@ -126,14 +162,14 @@ struct Channel {
     // points to storage of Connection::opByIOID
     std::map<uint32_t, RequestInfo*> opByIOID;
 
-    Channel(const std::shared_ptr<Context::Pvt>& context, const std::string& name, uint32_t cid);
+    Channel(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const std::string& name, uint32_t cid);
     ~Channel();
 
     void createOperations();
     void disconnect(const std::shared_ptr<Channel>& self);
 
     static
-    std::shared_ptr<Channel> build(const std::shared_ptr<Context::Pvt>& context, const std::string &name);
+    std::shared_ptr<Channel> build(const std::shared_ptr<Context::Pvt>& context, TCPWorker& worker, const std::string &name);
 };
 
 struct Context::Pvt
@@ -145,29 +181,47 @@ struct Context::Pvt
 
     const Value caMethod;
 
-    uint32_t nextCID=0u;
-
     evsocket searchTx;
     uint16_t searchRxPort;
 
     epicsTimeStamp lastPoke{};
 
     std::vector<uint8_t> searchMsg;
+    // copy of searchMsg with broadcast flags
+    std::vector<uint8_t> searchMsgBcast;
+    std::vector<evsocket::mmsg> searchTxMsgs;
+
+    // receive buffers for a batch of search replies
+    std::vector<uint8_t> searchRxBuf;
+    std::vector<evsocket::mmsg> searchRxMsgs;
 
     // search destination address and whether to set the unicast flag
     std::vector<std::pair<SockAddr, bool>> searchDest;
 
+    // only accessed from search_loop
+    struct Searching {
+        std::string name;
+        // number of repeatitions
+        size_t nSearch = 0u;
+        explicit Searching(const std::string& name) :name(name) {}
+    };
+    std::map<uint32_t, Searching> searchByCID;
+
     size_t currentBucket = 0u;
-    std::vector<std::list<std::weak_ptr<Channel>>> searchBuckets;
+    std::vector<std::list<uint32_t>> searchBuckets;
 
     std::list<std::unique_ptr<UDPListener> > beaconRx;
 
-    std::map<uint32_t, std::weak_ptr<Channel>> chanByCID;
-    std::map<std::string, std::weak_ptr<Channel>> chanByName;
+    // Channels are assigned to a worker by name
+    std::vector<std::unique_ptr<TCPWorker>> workers;
 
-    std::map<SockAddr, std::weak_ptr<Connection>> connByAddr;
+    // run user callbacks when Config::callback_workers!=0.  Each operation is bound to one.
+    // destroyed before workers
+    std::vector<std::unique_ptr<evbase>> callbackWorkers;
+    // round-robin selection of callback worker for next operation
+    std::atomic<size_t> nextCallbackWorker{0u};
 
-    evbase tcp_loop;
+    evbase search_loop;
     const evevent searchRx;
     const evevent searchTimer;
 
@@ -190,9 +244,18 @@ struct Context::Pvt
 
     void poke();
 
+    TCPWorker& workerFor(const std::string& name);
+
+    // may be called from any worker
+    void startSearch(const Channel& chan);
+    void stopSearch(std::vector<uint32_t>&& cids);
+
+    void onFound(TCPWorker& worker, const std::array<uint8_t, 12>& guid, const SockAddr& serv, const std::vector<uint32_t>& cids);
+
     void onBeacon(const UDPManager::Beacon& msg);
 
     bool onSearch();
+    void onSearchReply(uint8_t* buf, int nrx, const SockAddr& src);
     static void onSearchS(evutil_socket_t fd, short evt, void *raw);
     void tickSearch();
     static void tickSearchS(evutil_socket_t fd, short evt, void *raw);
@@ -39,8 +39,9 @@ struct InfoOp : public OperationBase
 
     virtual void cancel() override final {
         auto context = chan->context;
+        auto& loop = chan->worker.loop;
         decltype (done) junk;
-        context->tcp_loop.call([this, &junk](){
+        loop.call([this, &junk](){
             if(state==Waiting) {
                 chan->conn->sendDestroyRequest(chan->sid, ioid);
 
@@ -53,6 +54,7 @@ struct InfoOp : public OperationBase
             junk = std::move(done);
             // leave opByIOID for GC
         });
+        syncCallbacks(loop);
     }
 
     virtual void createOp() override final
@@ -145,11 +147,14 @@ void Connection::handle_GET_FIELD()
         } else {
             res = Result(std::make_exception_ptr(RemoteError(sts.msg)));
         }
-        try {
-            done(std::move(res));
-        }catch(std::exception& e){
-            log_err_printf(setup, "Unhandled exception %s in Info result() callback: %s\n", typeid (e).name(), e.what());
-        }
+        auto pres(std::make_shared<Result>(std::move(res)));
+        info->callback([done, pres]() {
+            try {
+                done(std::move(*pres));
+            }catch(std::exception& e){
+                log_err_printf(setup, "Unhandled exception %s in Info result() callback: %s\n", typeid (e).name(), e.what());
+            }
+        });
 
     } else {
         info->result = prototype;
@@ -162,8 +167,9 @@ std::shared_ptr<Operation> GetBuilder::_exec_info()
 
     assert(!_get);
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx, _name);
+    auto& worker = ctx->workerFor(_name);
+    worker.loop.call([&ret, &worker, this]() {
+        auto chan = Channel::build(ctx, worker, _name);
 
         auto op = std::make_shared<InfoOp>(chan);
         op->done = std::move(_result);
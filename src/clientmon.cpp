@@ -44,7 +44,7 @@ struct SubscriptionImpl : public OperationBase, public Subscription
     bool maskConn = false, maskDiscon = true;
     uint32_t queueSize = 4u, ackAt=0u;
 
-    // only access from tcp_loop
+    // only access from worker loop
 
     enum state_t : uint8_t {
         Connecting, // waiting for an active Channel
@@ -60,10 +60,12 @@ struct SubscriptionImpl : public OperationBase, public Subscription
 
     std::deque<Entry> queue;
     uint32_t window =0u, unack =0u;
+    // Values given to recycle(), which may be decoded into.  size()<=queueSize
+    std::vector<Value> spare;
 
     SubscriptionImpl(operation_t op, const std::shared_ptr<Channel>& chan)
         :OperationBase (op, chan)
-        ,ackTick(event_new(chan->context->tcp_loop.base, -1, EV_TIMEOUT, &tickAckS, this))
+        ,ackTick(event_new(chan->worker.loop.base, -1, EV_TIMEOUT, &tickAckS, this))
     {}
     virtual ~SubscriptionImpl() {
         cancel();
@@ -74,6 +76,21 @@ struct SubscriptionImpl : public OperationBase, public Subscription
         log_info_printf(io, "Server %s channel %s monitor notify\n",
                         chan->conn ? chan->conn->peerName.c_str() : "<disconnected>",
                         chan->name.c_str());
+        if(executor) {
+            // may be cancel()'d before the callback runs
+            std::weak_ptr<OperationBase> wself(shared_from_this());
+            executor->dispatch([wself]() {
+                if(auto self = wself.lock())
+                    static_cast<SubscriptionImpl*>(self.get())->doEvent();
+            });
+        } else {
+            doEvent();
+        }
+    }
+
+    // on executor, or worker loop.  cf. notify()
+    void doEvent()
+    {
         if(event) {
             try {
                 event(*this);
@@ -84,11 +101,42 @@ struct SubscriptionImpl : public OperationBase, public Subscription
         }
     }
 
+    // worker only.  A recycled Value of the same type, with no other references, to decode into.
+    Value takeSpare(const Value& prototype)
+    {
+        Value ret;
+        {
+            Guard G(lock);
+            if(!spare.empty()) {
+                ret = std::move(spare.back());
+                spare.pop_back();
+            }
+        }
+        if(ret && Value::Helper::desc(ret)==Value::Helper::desc(prototype)
+                && Value::Helper::store(ret).use_count()==1) {
+            ret.unmark();
+        } else {
+            ret = Value();
+        }
+        return ret;
+    }
+
+    virtual void recycle(Value&& val) override final
+    {
+        Value junk(std::move(val));
+        if(!junk)
+            return;
+
+        Guard G(lock);
+        if(spare.size() < queueSize)
+            spare.push_back(std::move(junk));
+    }
+
     virtual void pause(bool p) override final
     {
         if(!chan)
             return;
-        chan->context->tcp_loop.call([this, p](){
+        chan->worker.loop.call([this, p](){
             log_info_printf(io, "Server %s channel %s monitor %s\n",
                             chan->conn ? chan->conn->peerName.c_str() : "<disconnected>",
                             chan->name.c_str(),
@@ -153,8 +201,9 @@ struct SubscriptionImpl : public OperationBase, public Subscription
     virtual void cancel() override final
     {
         auto context = chan->context;
+        auto& loop = chan->worker.loop;
         decltype (event) junk;
-        context->tcp_loop.call([this, &junk](){
+        loop.call([this, &junk](){
             log_info_printf(io, "Server %s channel %s monitor cancel\n",
                             chan->conn ? chan->conn->peerName.c_str() : "<disconnected>",
                             chan->name.c_str());
@@ -171,9 +220,17 @@ struct SubscriptionImpl : public OperationBase, public Subscription
             }
             state = Done;
             chan.reset();
-            junk = std::move(event);
+            if(!executor)
+                junk = std::move(event);
             // leave opByIOID for GC
         });
+        if(executor && !loop.inLoop()) {
+            // event is only accessed from our executor.
+            // Also waits for a callback already running.
+            executor->call([this, &junk]() {
+                junk = std::move(event);
+            });
+        }
     }
 
     virtual void createOp() override final
@@ -196,7 +253,7 @@ struct SubscriptionImpl : public OperationBase, public Subscription
             to_wire(R, chan->sid);
             to_wire(R, ioid);
             to_wire(R, subcmd);
-            to_wire(R, Value::Helper::desc(pvRequest));
+            to_wire(R, Value::Helper::type(pvRequest), conn->txRegistry);
             to_wire_full(R, pvRequest);
             if(pipeline)
                 to_wire(R, queueSize);
@@ -346,7 +403,12 @@ void Connection::handle_MONITOR()
 
         } else if(!final || !M.empty()) {
 
-            data = info->prototype.cloneEmpty();
+            if(info->op==Operation::Monitor) {
+                if(auto op = info->handle.lock())
+                    data = static_cast<SubscriptionImpl*>(op.get())->takeSpare(info->prototype);
+            }
+            if(!data)
+                data = info->prototype.cloneEmpty();
             from_wire_valid(M, rxRegistry, data);
 
             BitMask overrun;
@@ -481,8 +543,9 @@ std::shared_ptr<Subscription> MonitorBuilder::exec()
 {
     std::shared_ptr<Subscription> ret;
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx, _name);
+    auto& worker = ctx->workerFor(_name);
+    worker.loop.call([&ret, &worker, this]() {
+        auto chan = Channel::build(ctx, worker, _name);
 
         auto op = std::make_shared<SubscriptionImpl>(Operation::Monitor, chan);
         op->event = std::move(_event);
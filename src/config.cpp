@@ -12,6 +12,7 @@
 #include <dbDefs.h>
 #include <osiSock.h>
 #include <epicsString.h>
+#include <epicsThread.h>
 
 #include <pvxs/log.h>
 #include "serverconn.h"
@@ -166,6 +167,30 @@ Config Config::from_env()
         }
     }
 
+    if(const char *env = pickenv(&name, {"EPICS_PVAS_TCP_WORKERS"})) {
+        try {
+            ret.tcp_workers = lexical_cast<unsigned>(env);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", name, e.what());
+        }
+    }
+
+    if(const char *env = pickenv(&name, {"EPICS_PVAS_CALLBACK_WORKERS"})) {
+        try {
+            ret.callback_workers = lexical_cast<unsigned>(env);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", name, e.what());
+        }
+    }
+
+    if(const char *env = pickenv(&name, {"EPICS_PVAS_LARGE_REPLY_SIZE"})) {
+        try {
+            ret.large_reply_size = lexical_cast<unsigned>(env);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", name, e.what());
+        }
+    }
+
     return ret;
 }
 
@@ -195,6 +220,12 @@ void Config::expand()
         auto_beacon = false;
     }
 
+    if(tcp_workers==0u) {
+        tcp_workers = epicsThreadGetCPUs();
+        if(tcp_workers==0u)
+            tcp_workers = 1u;
+    }
+
     removeDups(interfaces);
     removeDups(beaconDestinations);
 }
@@ -231,6 +262,12 @@ std::ostream& operator<<(std::ostream& strm, const Config& conf)
 
     strm<<"EPICS_PVAS_BROADCAST_PORT="<<conf.udp_port<<'\n';
 
+    strm<<"EPICS_PVAS_TCP_WORKERS="<<conf.tcp_workers<<'\n';
+
+    strm<<"EPICS_PVAS_CALLBACK_WORKERS="<<conf.callback_workers<<'\n';
+
+    strm<<"EPICS_PVAS_LARGE_REPLY_SIZE="<<conf.large_reply_size<<'\n';
+
     return strm;
 }
 
@@ -270,6 +307,22 @@ Config Config::from_env()
         }
     }
 
+    if(const char *env = pickenv(&name, {"EPICS_PVA_TCP_WORKERS"})) {
+        try {
+            ret.tcp_workers = lexical_cast<unsigned>(env);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", name, e.what());
+        }
+    }
+
+    if(const char *env = pickenv(&name, {"EPICS_PVA_CALLBACK_WORKERS"})) {
+        try {
+            ret.callback_workers = lexical_cast<unsigned>(env);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", name, e.what());
+        }
+    }
+
     return ret;
 }
 
@@ -286,6 +339,12 @@ void Config::expand()
         autoAddrList = false;
     }
 
+    if(tcp_workers==0u) {
+        tcp_workers = epicsThreadGetCPUs();
+        if(tcp_workers==0u)
+            tcp_workers = 1u;
+    }
+
     removeDups(addressList);
 }
 
@@ -308,6 +367,10 @@ std::ostream& operator<<(std::ostream& strm, const Config& conf)
 
     strm<<"EPICS_PVA_BROADCAST_PORT="<<conf.udp_port<<'\n';
 
+    strm<<"EPICS_PVA_TCP_WORKERS="<<conf.tcp_workers<<'\n';
+
+    strm<<"EPICS_PVA_CALLBACK_WORKERS="<<conf.callback_workers<<'\n';
+
     return strm;
 }
 
@@ -25,6 +25,10 @@ ConnBase::ConnBase(bool isClient, bufferevent* bev, const SockAddr& peerAddr)
     ,segCmd(0xff)
     ,segBuf(evbuffer_new())
     ,txBody(evbuffer_new())
+    ,txLarge(0u)
+    ,txHold(false)
+    ,txHeldLen(0u)
+    ,txTypes(0u)
 {
     // initially wait for at least a header
     bufferevent_setwatermark(this->bev.get(), EV_READ, 8, tcp_readahead);
@@ -40,14 +44,50 @@ const char* ConnBase::peerLabel() const
 void ConnBase::enqueueTxBody(pva_app_msg_t cmd)
 {
     auto tx = bufferevent_get_output(bev.get());
+    auto len = evbuffer_get_length(txBody.get());
+
+    // A message which defines new types must not be reordered after
+    // later messages which may refer to those types.
+    bool newTypes = txRegistry.size()!=txTypes;
+    txTypes = txRegistry.size();
+
+    if(txHold && txLarge && len > txLarge && txHeldLen < tcp_tx_limit && !newTypes) {
+        evbuf msg(evbuffer_new());
+        to_evbuf(msg.get(), Header{cmd,
+                                   uint8_t(isClient ? 0u : pva_flags::Server),
+                                   uint32_t(len)},
+                 hostBE);
+        auto err = evbuffer_add_buffer(msg.get(), txBody.get());
+        assert(!err);
+        txHeldLen += evbuffer_get_length(msg.get());
+        txHeld.push_back(std::move(msg));
+        return;
+    }
+
     to_evbuf(tx, Header{cmd,
                         uint8_t(isClient ? 0u : pva_flags::Server),
-                        uint32_t(evbuffer_get_length(txBody.get()))},
+                        uint32_t(len)},
              hostBE);
     auto err = evbuffer_add_buffer(tx, txBody.get());
     assert(!err);
 }
 
+void ConnBase::releaseTx()
+{
+    txHold = false;
+
+    while(!txHeld.empty()) {
+        auto msg(std::move(txHeld.front()));
+        txHeld.pop_front();
+
+        if(bev) {
+            auto err = evbuffer_add_buffer(bufferevent_get_output(bev.get()), msg.get());
+            assert(!err);
+        }
+    }
+    txHeldLen = 0u;
+}
+
 #define CASE(Op) void ConnBase::handle_##Op() {}
     CASE(ECHO);
     CASE(CONNECTION_VALIDATION);
@@ -144,7 +184,9 @@ void ConnBase::bevRead()
 
         // so far we do not use segmentation to support incremental processing
         // of long messages.  We instead accumulate all segments of a message
-        // prior to parsing.
+        // prior to parsing.  Segment bodies are moved (not copied) into segBuf,
+        // which EvInBuf drains as decoding proceeds.  Array payloads are copied
+        // directly into their destination, so a message is held ~once.
 
         auto seg = header[2]&pva_flags::SegMask;
 
@@ -6,6 +6,8 @@
 #ifndef CONN_H
 #define CONN_H
 
+#include <deque>
+
 #include "evhelper.h"
 #include "dataimpl.h"
 #include "utilpvt.h"
@@ -18,12 +20,17 @@ namespace impl {
 // at the price of maybe extra copying.
 constexpr size_t tcp_readahead = 0x1000u;
 
+// limit on size of TX buffer above which we suspend RX.
+// Also limits the total size of held messages.
+constexpr size_t tcp_tx_limit = 0x100000;
+
 struct ConnBase
 {
     SockAddr peerAddr;
     std::string peerName;
     evbufferevent bev;
     TypeStore rxRegistry;
+    TxTypeStore txRegistry;
 
     const bool isClient;
     bool peerBE;
@@ -32,6 +39,27 @@ struct ConnBase
     uint8_t segCmd;
     evbuf segBuf, txBody;
 
+    // While txHold, messages with bodies longer than txLarge (if non-zero)
+    // are held in txHeld until releaseTx(), so that shorter messages
+    // queued in the meantime are sent ahead of them.
+    // Holds up to tcp_tx_limit, then further large messages are queued directly.
+    size_t txLarge;
+    bool txHold;
+    std::deque<evbuf> txHeld;
+    // total length of txHeld
+    size_t txHeldLen;
+    // txRegistry.size() after the last message was queued
+    size_t txTypes;
+
+    // Hold large messages while in scope.  Then release them, even if unwinding.
+    struct HoldTx {
+        ConnBase& conn;
+        explicit HoldTx(ConnBase& conn) :conn(conn) { conn.txHold = true; }
+        ~HoldTx() { conn.releaseTx(); }
+        HoldTx(const HoldTx&) = delete;
+        HoldTx& operator=(const HoldTx&) = delete;
+    };
+
     ConnBase(bool isClient, bufferevent* bev, const SockAddr& peerAddr);
     ConnBase(const ConnBase&) = delete;
     ConnBase& operator=(const ConnBase&) = delete;
@@ -40,6 +68,7 @@ struct ConnBase
     const char* peerLabel() const;
 
     void enqueueTxBody(pva_app_msg_t cmd);
+    void releaseTx();
 
 protected:
 #define CASE(Op) virtual void handle_##Op();
@@ -5,6 +5,7 @@
  */
 
 #include <cstring>
+#include <algorithm>
 #include <epicsAssert.h>
 
 #include <epicsStdlib.h>
@@ -42,10 +43,9 @@ Value::Value(const std::shared_ptr<const impl::FieldDesc>& desc)
     if(!desc)
         return;
 
-    auto top = std::make_shared<StructTop>();
+    auto top = StructTop::build(desc->size());
 
     top->desc = desc;
-    top->members.resize(desc->size());
     {
         auto& root = top->members[0];
         root.init(desc.get());
@@ -55,14 +55,14 @@ Value::Value(const std::shared_ptr<const impl::FieldDesc>& desc)
     if(desc->code==TypeCode::Struct) {
         for(auto& pair : desc->mlookup) {
             auto cfld = desc.get() + pair.second;
-            auto& mem = top->members.at(pair.second);
+            auto& mem = top->members[pair.second];
             mem.top = top.get();
             mem.init(cfld);
         }
     }
 
     this->desc = desc.get();
-    decltype (store) val(top, top->members.data()); // alias
+    decltype (store) val(top, top->members); // alias
     this->store = std::move(val);
 }
 
@@ -113,16 +113,18 @@ Value& Value::assign(const Value& o)
     }
 
     if(desc) {
-        for(size_t bit=0, end=desc->size(); bit<end;) {
+        // visit only fields marked in o
+        auto& smarked = o.store->top->marked;
+        const size_t soff = o.store->index();
+
+        for(size_t bit = smarked.findSet(soff) - soff, end=desc->size();
+            bit<end;
+            bit = smarked.findSet(soff + bit) - soff)
+        {
             auto sstore = o.store.get() + bit;
             auto dstore = store.get() + bit;
 
-            if(!sstore->valid) {
-                bit++;
-                continue;
-            }
-
-            dstore->valid = true;
+            dstore->mark();
 
             switch(dstore->code) {
             case StoreType::Real:
@@ -153,7 +155,7 @@ Value& Value::assign(const Value& o)
                     auto sstore = o.store.get() + bit;
                     auto dstore = store.get() + bit;
 
-                    dstore->valid = true;
+                    dstore->mark();
 
                     switch(dstore->code) {
                     case StoreType::Real:
@@ -161,19 +163,15 @@ Value& Value::assign(const Value& o)
                     case StoreType::Integer:
                     case StoreType::UInteger:
                         dstore->as<uint64_t>() = sstore->as<uint64_t>();
-                        bit++;
                         break;
                     case StoreType::String:
                         dstore->as<std::string>() = sstore->as<std::string>();
-                        bit++;
                         break;
                     case StoreType::Array:
                         dstore->as<shared_array<const void>>() = sstore->as<shared_array<const void>>();
-                        bit++;
                         break;
                     case StoreType::Compound:
                         dstore->as<Value>() = sstore->as<Value>();
-                        bit++;
                         break;
                     case StoreType::Null: // skip sub-struct nodes, we will copy all leaf nodes
                         break;
@@ -188,6 +186,91 @@ Value& Value::assign(const Value& o)
     return *this;
 }
 
+namespace {
+bool sameArray(const shared_array<const void>& lhs, const shared_array<const void>& rhs, bool compareArrays)
+{
+    if(lhs.original_type()!=rhs.original_type() || lhs.size()!=rhs.size())
+        return false;
+    else if(lhs.data()==rhs.data() || lhs.empty())
+        return true;
+    else if(!compareArrays)
+        return false;
+
+    switch(lhs.original_type()) {
+    case ArrayType::Null:
+    case ArrayType::Value:
+        return false;
+    case ArrayType::String: {
+        auto L(lhs.castTo<const std::string>());
+        auto R(rhs.castTo<const std::string>());
+        return std::equal(L.begin(), L.end(), R.begin());
+    }
+    default:
+        // POD.  size() is in bytes
+        return memcmp(lhs.data(), rhs.data(), lhs.size())==0;
+    }
+}
+} // namespace
+
+bool Value::unmarkUnchanged(const Value& prev, bool compareArrays)
+{
+    if(!desc)
+        return false;
+    else if(desc!=prev.desc)
+        throw std::runtime_error("Can only compare same TypeDef");
+
+    bool changed = false;
+
+    auto& marked = store->top->marked;
+    const size_t off = store->index();
+
+    for(size_t bit = marked.findSet(off) - off, end=desc->size();
+        bit<end;
+        bit = marked.findSet(off + bit + 1u) - off)
+    {
+        auto dstore = store.get() + bit;
+        auto pstore = prev.store.get() + bit;
+
+        if(dstore->code==StoreType::Null) {
+            // marked sub-struct.  compare each decendent field instead
+            dstore->mark(false);
+            for(auto i : range(bit+1u, bit+desc[bit].size()))
+                (store.get() + i)->mark();
+            continue;
+        }
+
+        bool same = false;
+        switch(dstore->code) {
+        case StoreType::Real:
+        case StoreType::Bool:
+        case StoreType::Integer:
+        case StoreType::UInteger:
+            same = dstore->as<uint64_t>() == pstore->as<uint64_t>();
+            break;
+        case StoreType::String:
+            same = dstore->as<std::string>() == pstore->as<std::string>();
+            break;
+        case StoreType::Array:
+            same = sameArray(dstore->as<shared_array<const void>>(),
+                             pstore->as<shared_array<const void>>(),
+                             compareArrays);
+            break;
+        case StoreType::Compound:
+            same = dstore->as<Value>().compareInst(pstore->as<Value>());
+            break;
+        case StoreType::Null:
+            break;
+        }
+
+        if(same)
+            dstore->mark(false);
+        else
+            changed = true;
+    }
+
+    return changed;
+}
+
 Value Value::allocMember()
 {
     // allocate member type for Struct[] or Union[]
@@ -203,29 +286,26 @@ bool Value::isMarked(bool parents, bool children) const
     if(!desc)
         return false;
 
-    if(store->valid)
+    if(store->isMarked())
         return true;
 
     auto top = store->top;
 
     if(children && desc->size()>1u) {
-        // TODO more efficient
-        for(auto bit : range(desc->size()))
-        {
-            auto cstore = store.get() + bit;
-            if(cstore->valid)
-                return true;
-        }
+        auto idx = store->index();
+        if(top->marked.findSet(idx) < idx + desc->size())
+            return true;
     }
 
     if(parents) {
         auto pdesc = desc;
         auto pstore = store.get();
         while(pdesc!=top->desc.get()) {
-            pdesc -= pdesc->parent_index;
-            pstore -= pdesc->parent_index;
+            auto pidx = pdesc->parent_index;
+            pdesc -= pidx;
+            pstore -= pidx;
 
-            if(pstore->valid)
+            if(pstore->isMarked())
                 return true;
         }
     }
@@ -238,14 +318,14 @@ void Value::mark(bool v)
     if(!desc)
         return;
 
-    store->valid = v;
+    store->mark(v);
     if(!v)
         return;
 
     auto top = store->top;
     std::shared_ptr<FieldStorage> enc;
     while(top && (enc=top->enclosing.lock())) {
-        enc->valid = true;
+        enc->mark();
         top = enc->top;
     }
 }
@@ -255,26 +335,27 @@ void Value::unmark(bool parents, bool children)
     if(!desc)
         return;
 
-    store->valid = false;
+    store->mark(false);
 
     auto top = store->top;
 
     if(children && desc->size()>1u) {
-        // TODO more efficient
-        for(auto bit : range(desc->size()))
-        {
-            (store.get() + bit)->valid = false;
-        }
+        auto idx = store->index();
+        for(auto bit = top->marked.findSet(idx), end = idx + desc->size();
+            bit < end;
+            bit = top->marked.findSet(bit + 1u))
+            top->marked.set(bit, false);
     }
 
     if(parents) {
         auto pdesc = desc;
         auto pstore = store.get();
         while(pdesc!=top->desc.get()) {
-            pdesc -= pdesc->parent_index;
-            pstore -= pdesc->parent_index;
+            auto pidx = pdesc->parent_index;
+            pdesc -= pidx;
+            pstore -= pidx;
 
-            pstore->valid = false;
+            pstore->mark(false);
         }
     }
 }
@@ -308,7 +389,7 @@ const std::string &Value::nameOf(const Value& decendent) const
         throw NoField();
     auto pidx = store->index();
     auto didx = decendent.store->index();
-    if(pidx >= didx || didx >= store->top->members.size())
+    if(pidx >= didx || didx >= store->top->nmembers)
         throw std::logic_error("not a decendent");
 
     // inefficient, but we don't keep a reverse mapping
@@ -740,13 +821,62 @@ const Value Value::operator[](const char *name) const
     return ret;
 }
 
+FieldRef::FieldRef(const Value& proto, const std::string& name)
+    :offset(0u)
+    ,expr(name)
+{
+    auto fld(proto[name]);
+    if(!fld)
+        return;
+
+    auto pstore = Value::Helper::store_ptr(proto);
+    auto fstore = Value::Helper::store_ptr(fld);
+    auto pdesc = Value::Helper::desc(proto);
+    auto fdesc = Value::Helper::desc(fld);
+
+    // Only Struct members are at fixed offsets within the same FieldDesc and
+    // FieldStorage arrays.  Anything else (eg. selected Union member) is not.
+    if(pstore->top==fstore->top && fdesc>=pdesc && size_t(fdesc-pdesc)<pdesc->size()
+            && fdesc-pdesc == fstore-pstore)
+    {
+        base = Value::Helper::type(proto);
+        offset = fdesc-pdesc;
+    }
+}
+
+Value Value::operator[](const FieldRef& ref)
+{
+    if(desc && desc==ref.base.get()) {
+        Value ret;
+        ret.store = decltype(store)(store, store.get()+ref.offset);
+        ret.desc = desc+ref.offset;
+        return ret;
+
+    } else {
+        return (*this)[ref.expr.c_str()];
+    }
+}
+
+const Value Value::operator[](const FieldRef& ref) const
+{
+    if(desc && desc==ref.base.get()) {
+        Value ret;
+        ret.store = decltype(store)(store, store.get()+ref.offset);
+        ret.desc = desc+ref.offset;
+        return ret;
+
+    } else {
+        return (*this)[ref.expr.c_str()];
+    }
+}
+
 void Value::_iter_fl(Value::IterInfo &info, bool first) const
 {
     if(!store)
         throw NoField();
 
     if(info.depth) {
-        info.pos = info.nextcheck = store->index() + (first ? 1u : desc->size());
+        info.pos = info.nextcheck = first ? 1u : desc->size();
 
         if(info.marked)
             _iter_advance(info);
@@ -760,15 +890,14 @@ void Value::_iter_advance(IterInfo& info) const
 {
     assert(info.depth);
 
-    // scan forward to find next non-marked
-    for(auto idx : range(info.pos, desc->size())) {
-        auto S = store.get() + idx;
-        if(S->valid) {
-            auto D = desc + idx;
-            info.pos = idx;
-            info.nextcheck = idx + D->size();
-            return;
-        }
+    // find next marked
+    auto off = store->index();
+    auto idx = store->top->marked.findSet(off + info.pos) - off;
+    if(idx < desc->size()) {
+        auto D = desc + idx;
+        info.pos = idx;
+        info.nextcheck = idx + D->size();
+        return;
     }
 
     info.pos = info.nextcheck = desc->size();
@@ -954,10 +1083,71 @@ FieldStorage::~FieldStorage()
     deinit();
 }
 
-size_t FieldStorage::index() const
+namespace {
+/* Allocator for allocate_shared() which extends the single allocation holding
+ * the shared_ptr control block, and StructTop, to also hold the FieldStorage array,
+ * followed by the words of StructTop::marked.
+ * Reports the location of the FieldStorage array through *members,
+ * and of the (zeroed) mark words through *words.
+ */
+template<typename T>
+struct StructTopAlloc {
+    typedef T value_type;
+
+    size_t nmembers;
+    FieldStorage** members;
+    uint64_t** words;
+
+    StructTopAlloc(size_t nmembers, FieldStorage** members, uint64_t** words) :nmembers(nmembers), members(members), words(words) {}
+    template<typename U>
+    StructTopAlloc(const StructTopAlloc<U>& o) :nmembers(o.nmembers), members(o.members), words(o.words) {}
+
+    T* allocate(size_t n) {
+        // round up to alignment of FieldStorage
+        constexpr size_t align = alignof(FieldStorage);
+        static_assert(sizeof(FieldStorage)%alignof(uint64_t)==0u, "mark words follow FieldStorage array");
+        const size_t offset = (n*sizeof(T) + align-1u)/align*align;
+        const size_t nwords = (nmembers+63u)/64u;
+        const size_t woffset = offset + nmembers*sizeof(FieldStorage);
+
+        auto mem = static_cast<char*>(::operator new(woffset + nwords*sizeof(uint64_t)));
+        *members = reinterpret_cast<FieldStorage*>(mem + offset);
+        *words = reinterpret_cast<uint64_t*>(mem + woffset);
+        std::fill(*words, *words + nwords, 0u);
+        return reinterpret_cast<T*>(mem);
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p);
+    }
+
+    template<typename U>
+    bool operator==(const StructTopAlloc<U>& o) const { return members==o.members; }
+    template<typename U>
+    bool operator!=(const StructTopAlloc<U>& o) const { return members!=o.members; }
+};
+} // namespace
+
+std::shared_ptr<StructTop> StructTop::build(size_t nmembers)
 {
-    const size_t ret = this-top->members.data();
-    return ret;
+    FieldStorage* members = nullptr;
+    uint64_t* words = nullptr;
+    auto top(std::allocate_shared<StructTop>(StructTopAlloc<StructTop>(nmembers, &members, &words)));
+    assert(members && words);
+
+    for(auto i : range(nmembers))
+        new (&members[i]) FieldStorage();
+
+    top->members = members;
+    top->nmembers = nmembers;
+    top->marked.words = words;
+    top->marked.nbits = nmembers;
+    return top;
+}
+
+StructTop::~StructTop()
+{
+    for(auto i : range(nmembers))
+        members[nmembers-1u-i].~FieldStorage();
 }
 
 }} // namespace pvxs::impl
@@ -66,6 +66,34 @@ void to_wire(Buffer& buf, const FieldDesc* cur)
     }
 }
 
+// bound per-connection memory usage.  Further types are sent in full.
+constexpr size_t maxTxTypes = 1024u;
+
+void to_wire(Buffer& buf, const Type& type, TxTypeStore& cache)
+{
+    auto cur = type.get();
+
+    // other than (array of) struct and union, a description is no larger than a reference
+    if(cur && (cur->code==TypeCode::Struct || cur->code==TypeCode::Union
+               || cur->code==TypeCode::StructA || cur->code==TypeCode::UnionA))
+    {
+        auto it = cache.find(type);
+        if(it!=cache.end()) {
+            to_wire(buf, uint8_t(0xfe));
+            to_wire(buf, it->second);
+            return;
+
+        } else if(cache.size() < maxTxTypes) {
+            auto id = uint16_t(cache.size());
+            cache.emplace(type, id);
+            to_wire(buf, uint8_t(0xfd));
+            to_wire(buf, id);
+        }
+    }
+
+    to_wire(buf, cur);
+}
+
 void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, unsigned depth)
 {
     if(!buf.good() || depth>20) {
@@ -90,14 +118,10 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
             return;
 
         } else {
-            auto& entry = cache[key];
-            // copy new node, and any decendents into cache
-            entry.resize(descs.size()-index);
-            std::copy(descs.begin()+index,
-                      descs.end(),
-                      entry.begin());
-
             descs[index].parent_index = 0u; // our caller will set if actually is a parent.
+
+            // copy new node, and any decendents into cache
+            cache[key] = intern_type(std::vector<FieldDesc>(descs.begin()+index, descs.end()));
         }
 
     } else if(code.code==0xfe) {
@@ -109,16 +133,14 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
             buf.fault();
         }
 
-        if(!buf.good() || it->second.empty()) {
+        if(!buf.good() || !it->second) {
             buf.fault();
             return;
 
         } else {
             // copy from cache
-            descs.resize(index+it->second.size());
-            std::copy(it->second.begin(),
-                      it->second.end(),
-                      descs.begin()+index);
+            auto cached = it->second.get();
+            descs.insert(descs.end(), cached, cached+cached->size());
         }
 
     } else if(code.code!=0xff && code.code&0x10) {
@@ -196,6 +218,8 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
                     }
                 }
             }
+
+            build_plan(&descs[index]);
         }
             break;
         default:
@@ -235,11 +259,63 @@ void to_wire(Buffer& buf, const shared_array<const void>& varr)
     }
 }
 
+// arrays smaller than this are copied even when they could be referenced
+constexpr size_t minReferenceSize = 0x1000u;
+
+void releaseArray(const void *data, size_t datalen, void *extra)
+{
+    delete static_cast<shared_array<const void>*>(extra);
+}
+
+// arrays of fixed width elements are appended by reference if already in wire byte order,
+// or copied in bulk.
+template<typename E>
+void to_wire_bulk(Buffer& buf, const shared_array<const void>& varr)
+{
+    auto arr = varr.castTo<const E>();
+    to_wire(buf, Size{arr.size()});
+    if(!buf.good())
+        return;
+
+    const bool reverse = sizeof(E)>1 && (buf.be ^ hostBE);
+    const size_t nbytes = arr.size()*sizeof(E);
+
+    if(!reverse && nbytes >= minReferenceSize) {
+        // hold a reference to the array until the bytes have been sent
+        std::unique_ptr<shared_array<const void>> ref(new shared_array<const void>(varr));
+        if(buf.reference(arr.data(), nbytes, &releaseArray, ref.get())) {
+            ref.release(); // now owned by buf
+            return;
+        }
+    }
+
+    _to_wire_array<sizeof(E)>(buf, reinterpret_cast<const uint8_t*>(arr.data()), arr.size(), reverse);
+}
+
+// An array no one else references, of the same length and element type, may be decoded into.
+// eg. when a client decodes into a recycled Value.
+// nb. size() of a void array is in bytes.
+template<typename E>
+E* reusable(const shared_array<const void>& varr, size_t count)
+{
+    if(count && varr.size()==count*sizeof(E) && varr.unique() && varr.original_type()==detail::CaptureCode<E>::code)
+        return const_cast<E*>(static_cast<const E*>(varr.data()));
+    return nullptr;
+}
+
 template<typename E, typename C = E>
 void from_wire(Buffer& buf, shared_array<const void>& varr)
 {
     Size slen{};
     from_wire(buf, slen);
+    if(auto dest = reusable<E>(varr, slen.size)) {
+        for(auto i : range(slen.size)) {
+            C temp{};
+            from_wire(buf, temp);
+            dest[i] = temp;
+        }
+        return;
+    }
     shared_array<E> arr(slen.size);
     for(auto i : range(arr.size())) {
         C temp{};
@@ -248,24 +324,192 @@ void from_wire(Buffer& buf, shared_array<const void>& varr)
     }
     varr = arr.freeze().template castTo<const void>();
 }
+
+// strings are decoded in place to reuse their allocations
+template<>
+void from_wire<std::string>(Buffer& buf, shared_array<const void>& varr)
+{
+    Size slen{};
+    from_wire(buf, slen);
+    if(auto dest = reusable<std::string>(varr, slen.size)) {
+        for(auto i : range(slen.size))
+            from_wire(buf, dest[i]);
+        return;
+    }
+    shared_array<std::string> arr(slen.size);
+    for(auto i : range(arr.size()))
+        from_wire(buf, arr[i]);
+    varr = arr.freeze().template castTo<const void>();
+}
+
+// arrays of fixed width elements are copied directly into the new array
+template<typename E>
+void from_wire_bulk(Buffer& buf, shared_array<const void>& varr)
+{
+    Size slen{};
+    from_wire(buf, slen);
+    if(!buf.good())
+        return;
+    if(auto dest = reusable<E>(varr, slen.size)) {
+        _from_wire_array<sizeof(E)>(buf, reinterpret_cast<uint8_t*>(dest), slen.size, buf.be ^ hostBE);
+        return;
+    }
+    shared_array<E> arr(slen.size);
+    _from_wire_array<sizeof(E)>(buf, reinterpret_cast<uint8_t*>(arr.data()), arr.size(), buf.be ^ hostBE);
+    varr = arr.freeze().template castTo<const void>();
+}
+}
+
+namespace {
+// wire size of a fixed width field, or zero
+size_t fixed_size(TypeCode code)
+{
+    switch(code.code) {
+    case TypeCode::Bool:
+    case TypeCode::Int8:
+    case TypeCode::UInt8:
+        return 1u;
+    case TypeCode::Int16:
+    case TypeCode::UInt16:
+        return 2u;
+    case TypeCode::Int32:
+    case TypeCode::UInt32:
+    case TypeCode::Float32:
+        return 4u;
+    case TypeCode::Int64:
+    case TypeCode::UInt64:
+    case TypeCode::Float64:
+        return 8u;
+    default:
+        return 0u;
+    }
+}
+
+// Bound the size of a Batch, which must be contiguous in a Buffer
+constexpr size_t maxBatch = 512u;
+
+// assumes prior buf.ensure(M) where M>=sizeof(T)
+template<typename T>
+inline void to_wire_fixed(Buffer& buf, T val)
+{
+    typedef bswap<sizeof(T)> swap;
+    typename swap::type raw;
+    memcpy(&raw, &val, sizeof(T));
+    if(buf.be ^ hostBE)
+        raw = swap::op(raw);
+    memcpy(buf.save(), &raw, sizeof(T));
+    buf._skip(sizeof(T));
+}
+
+// assumes prior buf.ensure(M) where M>=sizeof(T)
+template<typename T>
+inline T from_wire_fixed(Buffer& buf)
+{
+    typedef bswap<sizeof(T)> swap;
+    typename swap::type raw;
+    memcpy(&raw, buf.save(), sizeof(T));
+    buf._skip(sizeof(T));
+    if(buf.be ^ hostBE)
+        raw = swap::op(raw);
+    T val;
+    memcpy(&val, &raw, sizeof(T));
+    return val;
+}
+} // namespace
+
+void build_plan(FieldDesc* desc)
+{
+    if(desc->code!=TypeCode::Struct)
+        return;
+
+    auto& plan = desc->plan;
+    plan.clear();
+
+    // index in plan of the Batch step for the current run of Fixed steps
+    size_t batch = size_t(-1);
+
+    for(auto off : range(size_t(1u), desc->size())) {
+        auto cdesc = desc + off;
+
+        if(cdesc->code==TypeCode::Struct) {
+            // a sub-structure has no encoding apart from its members
+
+        } else if(auto nbytes = fixed_size(cdesc->code)) {
+            if(batch==size_t(-1) || plan[batch].nbytes + nbytes > maxBatch) {
+                batch = plan.size();
+                plan.push_back(WireOp{WireOp::Batch, TypeCode::Null, 0u, 0u});
+            }
+            plan[batch].nbytes += nbytes;
+            plan[batch].offset++;
+            plan.push_back(WireOp{WireOp::Fixed, cdesc->code.code, 0u, uint32_t(off)});
+
+        } else {
+            batch = size_t(-1);
+            plan.push_back(WireOp{WireOp::Field, cdesc->code.code, 0u, uint32_t(off)});
+        }
+    }
+
+    plan.shrink_to_fit();
+}
+
+static
+void to_wire_field(Buffer& buf, const FieldDesc* desc, const FieldStorage* store);
+
+// serialize all decendents of a Struct
+static
+void to_wire_struct(Buffer& buf, const FieldDesc* desc, const FieldStorage* store)
+{
+    auto& plan = desc->plan;
+
+    for(size_t i=0u; i<plan.size(); i++) {
+        auto& op = plan[i];
+
+        if(op.kind==WireOp::Field) {
+            to_wire_field(buf, desc + op.offset, store + op.offset);
+            continue;
+        }
+
+        assert(op.kind==WireOp::Batch);
+        if(!buf.ensure(op.nbytes)) {
+            buf.fault();
+            return;
+        }
+
+        for(auto fop : range(i+1u, i+1u+op.offset)) {
+            auto& step = plan[fop];
+            auto fld = store + step.offset;
+            switch(step.code) {
+            case TypeCode::Bool:    to_wire_fixed(buf, uint8_t (fld->as<bool>())); break;
+            case TypeCode::Int8:    to_wire_fixed(buf, int8_t  (fld->as<int64_t>())); break;
+            case TypeCode::Int16:   to_wire_fixed(buf, int16_t (fld->as<int64_t>())); break;
+            case TypeCode::Int32:   to_wire_fixed(buf, int32_t (fld->as<int64_t>())); break;
+            case TypeCode::Int64:   to_wire_fixed(buf, int64_t (fld->as<int64_t>())); break;
+            case TypeCode::UInt8:   to_wire_fixed(buf, uint8_t (fld->as<uint64_t>())); break;
+            case TypeCode::UInt16:  to_wire_fixed(buf, uint16_t(fld->as<uint64_t>())); break;
+            case TypeCode::UInt32:  to_wire_fixed(buf, uint32_t(fld->as<uint64_t>())); break;
+            case TypeCode::UInt64:  to_wire_fixed(buf, uint64_t(fld->as<uint64_t>())); break;
+            case TypeCode::Float32: to_wire_fixed(buf, float   (fld->as<double>())); break;
+            case TypeCode::Float64: to_wire_fixed(buf, double  (fld->as<double>())); break;
+            default:
+                assert(false);
+                buf.fault();
+                return;
+            }
+        }
+        i += op.offset;
+    }
 }
 
 // serialize a field and all children (if Compound)
 static
-void to_wire_field(Buffer& buf, const FieldDesc* desc, const std::shared_ptr<const FieldStorage>& store)
+void to_wire_field(Buffer& buf, const FieldDesc* desc, const FieldStorage* store)
 {
     switch(store->code) {
     case StoreType::Null:
         switch(desc->code.code) {
-        case TypeCode::Struct: {
+        case TypeCode::Struct:
             // serialize entire sub-structure
-            for(auto off : range(desc->size())) {
-                auto cdesc = desc + off;
-                std::shared_ptr<const FieldStorage> cstore(store, store.get()+off); // TODO avoid shared_ptr/aliasing here
-                if(cdesc->code!=TypeCode::Struct)
-                    to_wire_field(buf, cdesc, cstore);
-            }
-        }
+            to_wire_struct(buf, desc, store);
             return;
         default: break;
         }
@@ -360,21 +604,21 @@ void to_wire_field(Buffer& buf, const FieldDesc* desc, const std::shared_ptr<con
             return;
         case TypeCode::Int8A:
         case TypeCode::UInt8A:
-            to_wire<uint8_t>(buf, fld);
+            to_wire_bulk<uint8_t>(buf, fld);
             return;
         case TypeCode::Int16A:
         case TypeCode::UInt16A:
-            to_wire<uint16_t>(buf, fld);
+            to_wire_bulk<uint16_t>(buf, fld);
             return;
         case TypeCode::Int32A:
         case TypeCode::UInt32A:
         case TypeCode::Float32A:
-            to_wire<uint32_t>(buf, fld);
+            to_wire_bulk<uint32_t>(buf, fld);
             return;
         case TypeCode::Int64A:
         case TypeCode::UInt64A:
         case TypeCode::Float64A:
-            to_wire<uint64_t>(buf, fld);
+            to_wire_bulk<uint64_t>(buf, fld);
             return;
         case TypeCode::StringA:
             to_wire<std::string, const std::string&>(buf, fld);
@@ -436,28 +680,109 @@ void to_wire_full(Buffer& buf, const Value& val)
 {
     assert(!!val);
 
-    to_wire_field(buf, Value::Helper::desc(val), Value::Helper::store(val));
+    to_wire_field(buf, Value::Helper::desc(val), Value::Helper::store_ptr(val));
+}
+
+// serialize fields with bits set in valid, except decendents of a set Struct, which are included with it.
+template<typename Mask>
+static
+void to_wire_marked(Buffer& buf, const FieldDesc* desc, const FieldStorage* store, const Mask& valid)
+{
+    for(auto bit = valid.findSet(0u);
+        bit<desc->size();)
+    {
+        auto cdesc = desc + bit;
+        to_wire_field(buf, cdesc, store+bit);
+        bit = valid.findSet(bit + cdesc->size());
+    }
 }
 
 void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask)
 {
     auto desc = Value::Helper::desc(val);
-    auto store = Value::Helper::store(val);
+    auto store = Value::Helper::store_ptr(val);
     assert(desc && desc->code==TypeCode::Struct);
     assert(!mask || mask->size()==desc->size());
 
-    BitMask valid(desc->size());
+    auto& marked = store->top->marked;
+    const size_t off = store->index();
 
-    for(auto bit : range(desc->size())) {
-        if((store.get()+bit)->valid && (!mask || (*mask)[bit]))
-            valid[bit] = true;
+    if(off==0u && !mask) {
+        // send StructTop::marked as is
+        to_wire(buf, marked.words, marked.wsize());
+        to_wire_marked(buf, desc, store, marked);
+        return;
+    }
+
+    BitMask valid;
+    if(off==0u) {
+        valid = marked & *mask;
+
+    } else {
+        valid.resize(desc->size());
+        for(auto bit = marked.findSet(off), end = off + desc->size();
+            bit < end;
+            bit = marked.findSet(bit + 1u))
+        {
+            if(!mask || (*mask)[bit - off])
+                valid[bit - off] = true;
+        }
     }
 
     to_wire(buf, valid);
+    to_wire_marked(buf, desc, store, valid);
+}
 
-    for(auto bit : valid.onlySet()) {
-        std::shared_ptr<const FieldStorage> cstore(store, store.get()+bit);
-        to_wire_field(buf, desc+bit, cstore);
+void to_wire_valid(Buffer& buf, const Value& base, const Value& delta, const BitMask* mask)
+{
+    auto desc = Value::Helper::desc(base);
+    auto bstore = Value::Helper::store_ptr(base);
+    auto dstore = Value::Helper::store_ptr(delta);
+    assert(desc && desc->code==TypeCode::Struct && desc==Value::Helper::desc(delta));
+    assert(bstore->index()==0u && dstore->index()==0u);
+    const size_t nfld = desc->size();
+    assert(!mask || mask->size()==nfld);
+
+    // Which Value each field is taken from.  A marked Struct includes all decendents.
+    enum : uint8_t {None, FromBase, FromDelta};
+    std::vector<uint8_t> from(nfld, None);
+    for(size_t bit=0u; bit<nfld; bit++) {
+        auto inherit = bit ? from[bit - desc[bit].parent_index] : uint8_t(None);
+        bool selected = !mask || (*mask)[bit];
+        if(inherit==FromDelta || (selected && dstore[bit].isMarked()))
+            from[bit] = FromDelta;
+        else if(selected && bstore[bit].isMarked())
+            from[bit] = FromBase;
+        else
+            from[bit] = inherit;
+    }
+
+    // A Struct is sent whole when all decendents come from the same Value,
+    // otherwise its members are sent individually.
+    BitMask valid;
+    valid.resize(nfld);
+    for(size_t bit=0u; bit<nfld;) {
+        auto end = bit + desc[bit].size();
+        bool uniform = true;
+        for(auto i = bit+1u; uniform && i<end; i++)
+            uniform = from[i]==from[bit];
+
+        if(!uniform) {
+            bit++;
+        } else {
+            if(from[bit]!=None)
+                valid[bit] = true;
+            bit = end;
+        }
+    }
+
+    to_wire(buf, valid);
+    for(auto bit = valid.findSet(0u);
+        bit<nfld;)
+    {
+        auto cdesc = desc + bit;
+        to_wire_field(buf, cdesc, (from[bit]==FromDelta ? dstore : bstore) + bit);
+        bit = valid.findSet(bit + cdesc->size());
     }
 }
 
@@ -471,23 +796,93 @@ T from_wire_as(Buffer& buf)
 }
 }
 
+// deserialize type description.  Returns NULL for Null type.
+static
+Type from_wire_type(Buffer& buf, TypeStore& ctxt)
+{
+    if(!buf.empty() && buf[0]==0xfe) {
+        // reference to a whole type already in the cache.  No need to copy.
+        buf._skip(1u);
+        uint16_t key=0;
+        from_wire(buf, key);
+        auto it = ctxt.find(key);
+        if(!buf.good() || it==ctxt.end() || !it->second) {
+            buf.fault();
+            return Type();
+        }
+        return it->second;
+    }
+
+    std::vector<FieldDesc> descs;
+    from_wire(buf, descs, ctxt);
+    if(!buf.good())
+        return Type();
+
+    return intern_type(std::move(descs));
+}
+
+static
+void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc,
+                     const std::shared_ptr<FieldStorage>& owner, FieldStorage* store);
+
+// deserialize all decendents of a Struct.
+// owner shares ownership of store, and is only used when a Compound field needs to reference it.
+static
+void from_wire_struct(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc,
+                      const std::shared_ptr<FieldStorage>& owner, FieldStorage* store)
+{
+    auto& plan = desc->plan;
+
+    for(size_t i=0u; i<plan.size(); i++) {
+        auto& op = plan[i];
+
+        if(op.kind==WireOp::Field) {
+            from_wire_field(buf, ctxt, desc + op.offset, owner, store + op.offset);
+            (store + op.offset)->mark();
+            continue;
+        }
+
+        assert(op.kind==WireOp::Batch);
+        if(!buf.ensure(op.nbytes)) {
+            buf.fault();
+            return;
+        }
+
+        for(auto fop : range(i+1u, i+1u+op.offset)) {
+            auto& step = plan[fop];
+            auto fld = store + step.offset;
+            switch(step.code) {
+            case TypeCode::Bool:    fld->as<bool>() = 0!=from_wire_fixed<uint8_t>(buf); break;
+            case TypeCode::Int8:    fld->as<int64_t>() = from_wire_fixed<int8_t>(buf); break;
+            case TypeCode::Int16:   fld->as<int64_t>() = from_wire_fixed<int16_t>(buf); break;
+            case TypeCode::Int32:   fld->as<int64_t>() = from_wire_fixed<int32_t>(buf); break;
+            case TypeCode::Int64:   fld->as<int64_t>() = from_wire_fixed<int64_t>(buf); break;
+            case TypeCode::UInt8:   fld->as<uint64_t>() = from_wire_fixed<uint8_t>(buf); break;
+            case TypeCode::UInt16:  fld->as<uint64_t>() = from_wire_fixed<uint16_t>(buf); break;
+            case TypeCode::UInt32:  fld->as<uint64_t>() = from_wire_fixed<uint32_t>(buf); break;
+            case TypeCode::UInt64:  fld->as<uint64_t>() = from_wire_fixed<uint64_t>(buf); break;
+            case TypeCode::Float32: fld->as<double>() = from_wire_fixed<float>(buf); break;
+            case TypeCode::Float64: fld->as<double>() = from_wire_fixed<double>(buf); break;
+            default:
+                buf.fault();
+                return;
+            }
+            fld->mark();
+        }
+        i += op.offset;
+    }
+}
+
 static
-void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store)
+void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc,
+                     const std::shared_ptr<FieldStorage>& owner, FieldStorage* store)
 {
     switch(store->code) {
     case StoreType::Null:
         switch(desc->code.code) {
-        case TypeCode::Struct: {
-            // serialize entire sub-structure
-            for(auto off : range(desc->size())) {
-                auto cdesc = desc + off;
-                std::shared_ptr<FieldStorage> cstore(store, store.get()+off); // TODO avoid shared_ptr/aliasing here
-                if(cdesc->code!=TypeCode::Struct) {
-                    from_wire_field(buf, ctxt, cdesc, cstore);
-                    cstore->valid = true;
-                }
-            }
-        }
+        case TypeCode::Struct:
+            // deserialize entire sub-structure
+            from_wire_struct(buf, ctxt, desc, owner, store);
             return;
         default: break;
         }
@@ -515,10 +910,10 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
     case StoreType::UInteger: {
         auto& fld = store->as<uint64_t>();
         switch(desc->code.code) {
-        case TypeCode::UInt8:  fld = from_wire_as<int8_t>(buf); return;
-        case TypeCode::UInt16: fld = from_wire_as<int16_t>(buf); return;
-        case TypeCode::UInt32: fld = from_wire_as<int32_t>(buf); return;
-        case TypeCode::UInt64: fld = from_wire_as<int64_t>(buf); return;
+        case TypeCode::UInt8:  fld = from_wire_as<uint8_t>(buf); return;
+        case TypeCode::UInt16: fld = from_wire_as<uint16_t>(buf); return;
+        case TypeCode::UInt32: fld = from_wire_as<uint32_t>(buf); return;
+        case TypeCode::UInt64: fld = from_wire_as<uint64_t>(buf); return;
         default: break;
         }
     }
@@ -552,7 +947,7 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             } else if(select.size < desc->miter.size()) {
                 std::shared_ptr<const FieldDesc> stype(store->top->desc,
                                                        &desc->members[desc->miter[select.size].second]); // alias
-                fld = Value::Helper::build(stype, store, desc);
+                fld = Value::Helper::build(stype, std::shared_ptr<FieldStorage>(owner, store), desc);
 
                 from_wire_full(buf, ctxt, fld);
                 return;
@@ -561,18 +956,15 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             break;
 
         case TypeCode::Any: {
-            auto descs(std::make_shared<std::vector<FieldDesc>>());
-
-            from_wire(buf, *descs, ctxt);
+            auto stype(from_wire_type(buf, ctxt));
             if(!buf.good())
                 return;
 
-            if(descs->empty()) {
+            if(!stype) {
                 fld = Value();
                 return;
 
             } else {
-                std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
                 fld = Value::Helper::build(stype);
 
                 from_wire_full(buf, ctxt, fld);
@@ -594,21 +986,21 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             return;
         case TypeCode::Int8A:
         case TypeCode::UInt8A:
-            from_wire<uint8_t>(buf, fld);
+            from_wire_bulk<uint8_t>(buf, fld);
             return;
         case TypeCode::Int16A:
         case TypeCode::UInt16A:
-            from_wire<uint16_t>(buf, fld);
+            from_wire_bulk<uint16_t>(buf, fld);
             return;
         case TypeCode::Int32A:
         case TypeCode::UInt32A:
         case TypeCode::Float32A:
-            from_wire<uint32_t>(buf, fld);
+            from_wire_bulk<uint32_t>(buf, fld);
             return;
         case TypeCode::Int64A:
         case TypeCode::UInt64A:
         case TypeCode::Float64A:
-            from_wire<uint64_t>(buf, fld);
+            from_wire_bulk<uint64_t>(buf, fld);
             return;
         case TypeCode::StringA:
             from_wire<std::string>(buf, fld);
@@ -619,9 +1011,10 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             shared_array<Value> arr(alen.size);
             std::shared_ptr<const FieldDesc> etype(store->top->desc,
                                                    &desc->members[0]); // alias
+            std::shared_ptr<FieldStorage> pstore(owner, store); // alias
             for(auto& elem : arr) {
                 if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
-                    elem = Value::Helper::build(etype, store, desc);
+                    elem = Value::Helper::build(etype, pstore, desc);
 
                     from_wire_full(buf, ctxt, elem);
                 }
@@ -635,6 +1028,7 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             from_wire(buf, alen);
             shared_array<Value> arr(alen.size);
             auto cdesc = &desc->members[0];
+            std::shared_ptr<FieldStorage> pstore(owner, store); // alias
 
             for(auto& elem : arr) {
                 if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
@@ -647,7 +1041,7 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
                     } else if(select.size < cdesc->miter.size()) {
                         std::shared_ptr<const FieldDesc> stype(store->top->desc,
                                                                &cdesc->members[cdesc->miter[select.size].second]); // alias
-                        elem = Value::Helper::build(stype, store, desc);
+                        elem = Value::Helper::build(stype, pstore, desc);
 
                         from_wire_full(buf, ctxt, elem);
 
@@ -669,16 +1063,12 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
 
             for(auto& elem : arr) {
                 if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
-                    auto descs(std::make_shared<std::vector<FieldDesc>>());
-
-                    from_wire(buf, *descs, ctxt);
+                    auto stype(from_wire_type(buf, ctxt));
                     if(!buf.good())
                         return;
 
-                    if(!descs->empty()) {
-
-                        std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
-                        elem = Value::Helper::build(stype, store, desc);
+                    if(stype) {
+                        elem = Value::Helper::build(stype, std::shared_ptr<FieldStorage>(owner, store), desc);
 
                         from_wire_full(buf, ctxt, elem);
                     }
@@ -702,7 +1092,8 @@ void from_wire_full(Buffer& buf, TypeStore& ctxt, Value& val)
 {
     assert(!!val);
 
-    from_wire_field(buf, ctxt, Value::Helper::desc(val), Value::Helper::store(val));
+    auto& store = Value::Helper::store(val);
+    from_wire_field(buf, ctxt, Value::Helper::desc(val), store, store.get());
 }
 
 void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val)
@@ -720,32 +1111,28 @@ void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val)
     BitMask valid;
     from_wire(buf, valid);
     // encoding rounds # of bits to whole bytes, so we may trim
-    valid.resize(top->members.size());
+    valid.resize(top->nmembers);
     if(!buf.good())
         return;
 
     for(auto bit = valid.findSet(0u);
         bit<desc->size();)
     {
-        std::shared_ptr<FieldStorage> cstore(store, store.get()+bit);
+        auto cstore = store.get()+bit;
         auto cdesc = desc + bit;
-        from_wire_field(buf, ctxt, cdesc, cstore);
-        cstore->valid = true;
+        from_wire_field(buf, ctxt, cdesc, store, cstore);
+        cstore->mark();
         bit = valid.findSet(bit + cdesc->size());
     }
 }
 
 void from_wire_type(Buffer& buf, TypeStore& ctxt, Value& val)
 {
-    auto descs(std::make_shared<std::vector<FieldDesc>>());
-
-    from_wire(buf, *descs, ctxt);
+    auto stype(from_wire_type(buf, ctxt));
     if(!buf.good())
         return;
 
-    if(!descs->empty()) {
-
-        std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
+    if(stype) {
         val = Value::Helper::build(stype);
 
     } else {
@@ -9,6 +9,10 @@
 #include <string>
 #include <map>
 
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
 #include <pvxs/data.h>
 #include <pvxs/sharedArray.h>
 #include <pvxs/bitmask.h>
@@ -40,6 +44,26 @@ struct Value::Helper {
 namespace impl {
 struct Buffer;
 
+/** One step of the (de)serialization of all fields of a Struct.  cf. FieldDesc::plan
+ *
+ * Each run of consecutive fixed width fields is preceded by a Batch step,
+ * allowing a single bounds check for the whole run.
+ */
+struct WireOp {
+    enum kind_t : uint8_t {
+        Batch, // following 'count' steps are Fixed, and total 'nbytes'
+        Fixed, // Bool, integer, or real.  (de)serialized inline
+        Field, // any other leaf.  Delegate to to_wire_field()/from_wire_field()
+    };
+    kind_t kind;
+    TypeCode::code_t code;
+    // Batch: total size in bytes of the following Fixed steps
+    uint16_t nbytes;
+    // Batch: number of following Fixed steps.
+    // Otherwise, offset of the field in FieldDesc and FieldStorage arrays.  Relative to the Struct
+    uint32_t offset;
+};
+
 /** Describes a single field, leaf or otherwise, in a nested structure.
  *
  * FieldDesc are always stored depth first as a contigious array,
@@ -79,16 +103,45 @@ struct FieldDesc {
     // For UnionA/StructA, size()==1 containing a Union/Struct
     std::vector<FieldDesc> members;
 
+    // For Struct, steps to (de)serialize all decendent fields, in wire order.
+    // Filled by build_plan() once this node and all decendents are complete.
+    std::vector<WireOp> plan;
+
     TypeCode code{TypeCode::Null};
 
     // number of FieldDesc nodes which describe this node.  Inclusive.  always size()>=1
     inline size_t size() const { return 1u + (members.empty() ? mlookup.size() : 0u); }
 };
 
+//! Fill in FieldDesc::plan of a Struct from its (complete) decendents.  No-op for other types.
+void build_plan(FieldDesc* desc);
+
+using Type = std::shared_ptr<const FieldDesc>;
+
+/** Return a shared, immutable, type tree equal to descs[0] and its decendents.
+ *
+ * Identical types, whether built with TypeDef or received from any connection,
+ * share a single tree for as long as any reference remains.
+ * Returns NULL if descs is empty.
+ */
+PVXS_API
+Type intern_type(std::vector<FieldDesc>&& descs);
+
 PVXS_API
 void to_wire(Buffer& buf, const FieldDesc* cur);
 
-typedef std::map<uint16_t, std::vector<FieldDesc>> TypeStore;
+//! Receiver side of a type cache.  Maps cache key to a type from intern_type()
+typedef std::map<uint16_t, Type> TypeStore;
+
+//! Sender side of a type cache.  Maps type to the cache key previously assigned.
+//! As types are interned, identical descriptions share one entry.
+//! Holding a reference prevents the address of a released type from being re-used.
+typedef std::map<Type, uint16_t> TxTypeStore;
+
+//! serialize type description, or a reference to an identical description already sent.
+//! The receiver must decode every message which might include a new cache entry.
+PVXS_API
+void to_wire(Buffer& buf, const Type& type, TxTypeStore& cache);
 
 PVXS_API
 void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, unsigned depth=0);
@@ -112,16 +165,20 @@ struct FieldStorage {
                        Value, // Union, Any
                        shared_array<const void> // array of POD, std::string, or std::shared_ptr<Value>
     >::type store;
-    // index of this field in StructTop::members
+    // the Struct (or single field) which includes this field
     StructTop *top;
-    bool valid=false;
     StoreType code=StoreType::Null;
 
     void init(const FieldDesc* desc);
     void deinit();
     ~FieldStorage();
 
-    size_t index() const;
+    // index of this field in StructTop::members
+    inline size_t index() const;
+
+    // marked as valid/changed.  Stored in StructTop::marked
+    inline bool isMarked() const;
+    inline void mark(bool v=true);
 
     template<typename T>
     T& as() { return *reinterpret_cast<T*>(&store); }
@@ -132,20 +189,72 @@ struct FieldStorage {
     inline const uint8_t* buffer() const { return reinterpret_cast<const uint8_t*>(&store); }
 };
 
+/* Non-owning view of one mark bit per FieldStorage.
+ * May be used in BitMask expressions.
+ */
+struct MarkedBits : public detail::BitBase<MarkedBits> {
+    uint64_t* words = nullptr;
+    size_t nbits = 0u;
+
+    size_t size() const { return nbits; }
+    size_t wsize() const { return (nbits+63u)/64u; }
+    uint64_t word(size_t i) const { return words[i]; }
+
+    bool operator[](size_t bit) const {
+        return words[bit/64u] & (uint64_t(1u)<<(bit%64u));
+    }
+    // Atomic, as the bits of different fields share a word, and different
+    // fields of one Value may be marked from different threads.
+    void set(size_t bit, bool v=true) {
+        auto& word = words[bit/64u];
+        const uint64_t mask = uint64_t(1u)<<(bit%64u);
+#if defined(__GNUC__)
+        if(v)
+            (void)__atomic_fetch_or(&word, mask, __ATOMIC_RELAXED);
+        else
+            (void)__atomic_fetch_and(&word, ~mask, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+        static_assert(sizeof(word)==sizeof(__int64), "");
+        if(v)
+            (void)_InterlockedOr64(reinterpret_cast<volatile __int64*>(&word), __int64(mask));
+        else
+            (void)_InterlockedAnd64(reinterpret_cast<volatile __int64*>(&word), __int64(~mask));
+#else
+#  error Atomic 64-bit OR and AND not implemented for this compiler
+#endif
+    }
+    //! cf. BitMask::findSet()
+    size_t findSet(size_t start=0u) const { return impl::findSet(words, nbits, start); }
+};
+
 // hidden (publicly) management of an allocated Struct
 struct StructTop {
     // type of first top level struct.  always !NULL.
     // Actually the first element of a vector<const FieldDesc>
     std::shared_ptr<const FieldDesc> desc;
-    // our members (inclusive).  always size()>=1
-    std::vector<FieldStorage> members;
+    // our members (inclusive).  always nmembers>=1
+    // Stored in the same allocation as this StructTop.  see StructTop::build()
+    FieldStorage* members = nullptr;
+    size_t nmembers = 0u;
+    // bit N set when members[N] is marked.  size()==nmembers
+    // Stored in the same allocation, after members.
+    MarkedBits marked;
 
     // empty, or the field of a structure which encloses this.
     std::weak_ptr<FieldStorage> enclosing;
-};
 
-using Type = std::shared_ptr<const FieldDesc>;
+    StructTop() = default;
+    StructTop(const StructTop&) = delete;
+    StructTop& operator=(const StructTop&) = delete;
+    ~StructTop();
 
+    // allocate with storage for nmembers
+    static std::shared_ptr<StructTop> build(size_t nmembers);
+};
+
+size_t FieldStorage::index() const { return this - top->members; }
+bool FieldStorage::isMarked() const { return top->marked[index()]; }
+void FieldStorage::mark(bool v) { top->marked.set(index(), v); }
 
 //! serialize all Value fields
 PVXS_API
@@ -155,6 +264,11 @@ void to_wire_full(Buffer& buf, const Value& val);
 PVXS_API
 void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask=nullptr);
 
+//! serialize BitMask and marked valid fields of two top level Values of the same type.
+//! Fields marked in delta take precedence over base.
+PVXS_API
+void to_wire_valid(Buffer& buf, const Value& base, const Value& delta, const BitMask* mask=nullptr);
+
 //! deserialize type description
 PVXS_API
 void from_wire_type(Buffer& buf, TypeStore& ctxt, Value& val);
@@ -8,9 +8,17 @@
 #include <mswsock.h>
 #endif
 
+#if defined(__linux__)
+#  include <sys/socket.h>
+#  ifdef MSG_WAITFORONE
+#    define HAVE_MMSG
+#  endif
+#endif
+
 #include <cstring>
 #include <system_error>
 #include <deque>
+#include <atomic>
 
 #include <event2/event.h>
 #include <event2/thread.h>
@@ -59,27 +67,59 @@ struct evbase::Pvt : public epicsThreadRunable
         std::function<void()> fn;
         std::exception_ptr *result;
         epicsEvent *notify;
-        Work(const std::function<void()>& fn, std::exception_ptr *result, epicsEvent *notify)
-            :fn(fn), result(result), notify(notify)
+        Work(std::function<void()>&& fn, std::exception_ptr *result, epicsEvent *notify)
+            :fn(std::move(fn)), result(result), notify(notify)
         {}
     };
-    std::deque<Work> actions;
+
+    /* Bounded multi-producer, single consumer, queue.
+     * cf. Dmitry Vyukov's bounded MPMC queue.
+     *
+     * Each Cell::seq is advanced by the producer which fills it,
+     * then by the consumer (the worker thread) which empties it.
+     */
+    struct Cell {
+        std::atomic<size_t> seq;
+        aligned_union<8, Work>::type storage;
+        Work& work() { return *reinterpret_cast<Work*>(&storage); }
+    };
+    static constexpr size_t nCells = 1024u; // power of 2
+    std::unique_ptr<Cell[]> cells;
+    std::atomic<size_t> enqPos;
+    size_t deqPos; // worker only
+    // true after dowork event added, until worker begins emptying the queue
+    std::atomic<bool> wakeup;
+
+    // used when all cells are full.  Guarded by lock
+    std::deque<Work> overflow;
+    // overflow.size()!=0.  When set, all Work is added to overflow to preserve order
+    std::atomic<bool> overflowing;
 
     std::unique_ptr<event_base> base;
     evevent dowork;
+    // worker only.  set when evbase is destroyed from a callback on the worker.  run() will delete this
+    bool orphaned = false;
     epicsEvent start_sync;
     epicsMutex lock;
 
     epicsThread worker;
 
     Pvt(const std::string& name, unsigned prio)
-        :base(nullptr)
+        :cells(new Cell[nCells])
+        ,enqPos(0u)
+        ,deqPos(0u)
+        ,wakeup(false)
+        ,overflowing(false)
+        ,base(nullptr)
         ,worker(*this, name.c_str(),
                 epicsThreadGetStackSize(epicsThreadStackBig),
                 prio)
     {
         epicsThreadOnce(&evthread_once, &evthread_init, nullptr);
 
+        for(auto i : range(nCells))
+            cells[i].seq.store(i, std::memory_order_relaxed);
+
         worker.start();
         start_sync.wait();
         if(!base) {
@@ -91,6 +131,69 @@ struct evbase::Pvt : public epicsThreadRunable
         if(event_base_loopexit(base.get(), nullptr))
             log_crit_printf(logerr, "evbase error while interrupting loop for %p\n", base.get());
         worker.exitWait();
+
+        // discard any remaining
+        while(pop()) {}
+    }
+
+    void push(std::function<void()>&& fn, std::exception_ptr *result, epicsEvent *notify)
+    {
+        if(!overflowing.load(std::memory_order_acquire)) {
+            auto pos = enqPos.load(std::memory_order_relaxed);
+            for(;;) {
+                auto& cell = cells[pos & (nCells-1u)];
+                auto seq = cell.seq.load(std::memory_order_acquire);
+                auto diff = intptr_t(seq) - intptr_t(pos);
+
+                if(diff==0) {
+                    // cell is empty.  try to claim it
+                    if(enqPos.compare_exchange_weak(pos, pos+1u, std::memory_order_relaxed)) {
+                        new (&cell.storage) Work(std::move(fn), result, notify);
+                        cell.seq.store(pos+1u, std::memory_order_release);
+                        notifyWorker();
+                        return;
+                    }
+                    // pos updated to current enqPos
+
+                } else if(diff<0) {
+                    break; // full
+
+                } else {
+                    // another producer claimed this cell
+                    pos = enqPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        {
+            Guard G(lock);
+            overflow.emplace_back(std::move(fn), result, notify);
+            overflowing.store(true, std::memory_order_release);
+        }
+        notifyWorker();
+    }
+
+    // worker only.  Move next Work from a cell.
+    bool pop(Work* out=nullptr)
+    {
+        auto& cell = cells[deqPos & (nCells-1u)];
+        auto seq = cell.seq.load(std::memory_order_acquire);
+        if(seq != deqPos+1u)
+            return false; // empty, or producer not finished
+
+        if(out)
+            new (out) Work(std::move(cell.work()));
+        cell.work().~Work();
+        cell.seq.store(deqPos + nCells, std::memory_order_release);
+        deqPos++;
+        return true;
+    }
+
+    void notifyWorker()
+    {
+        timeval now{};
+        if(!wakeup.exchange(true, std::memory_order_acq_rel) && event_add(dowork.get(), &now))
+            throw std::runtime_error("Unable to wakeup evbase");
     }
 
     virtual void run() override final
@@ -119,29 +222,79 @@ struct evbase::Pvt : public epicsThreadRunable
                             e.what());
             start_sync.trigger();
         }
+
+        if(orphaned)
+            delete this;
     }
 
-    void doWork()
+    void execute(Work& work)
     {
-        decltype (actions) todo;
-        {
-            Guard G(lock);
-            todo = std::move(actions);
+        try {
+            work.fn();
+        }catch(std::exception& e){
+            if(work.result) {
+                Guard G(lock);
+                *work.result = std::current_exception();
+            } else {
+                log_crit_printf(logerr, "Unhandled exception in event_base : %s : %s\n",
+                                typeid(e).name(), e.what());
+            }
         }
-        for(auto& work : todo) {
+        if(work.notify)
+            work.notify->trigger();
+    }
+
+    void doWork()
+    {
+        // any push() after this point will wake us again.
+        // exchange() to synchronize with the exchange() in notifyWorker()
+        (void)wakeup.exchange(false, std::memory_order_acq_rel);
+
+        // bound the number of cells handled in one pass to allow
+        // other events to be processed.
+        bool limited = true;
+        for(auto i : range(nCells)) {
+            (void)i;
+            aligned_union<8, Work>::type storage;
+            auto& work = *reinterpret_cast<Work*>(&storage);
+            if(!pop(&work)) {
+                limited = false;
+                break;
+            }
+
             try {
-                work.fn();
-            }catch(std::exception& e){
-                if(work.result) {
-                    Guard G(lock);
-                    *work.result = std::current_exception();
-                } else {
-                    log_crit_printf(logerr, "Unhandled exception in event_base : %s : %s\n",
-                                    typeid(e).name(), e.what());
-                }
+                execute(work);
+            }catch(...){
+                work.~Work();
+                throw;
+            }
+            work.~Work();
+
+            if(orphaned)
+                return; // discard remaining
+        }
+
+        if(limited) {
+            // more to do
+            notifyWorker();
+
+        } else if(deqPos != enqPos.load(std::memory_order_acquire)) {
+            // a producer is filling a cell, and will wake us when it is done.
+            // Overflow Work must wait until all preceding cells are executed.
+
+        } else if(overflowing.load(std::memory_order_acquire)) {
+            decltype (overflow) todo;
+            {
+                Guard G(lock);
+                todo = std::move(overflow);
+                overflow.clear();
+                overflowing.store(false, std::memory_order_release);
+            }
+            for(auto& work : todo) {
+                execute(work);
+                if(orphaned)
+                    return;
             }
-            if(work.notify)
-                work.notify->trigger();
         }
     }
     static
@@ -156,12 +309,23 @@ struct evbase::Pvt : public epicsThreadRunable
     }
 };
 
+constexpr size_t evbase::Pvt::nCells;
+
 evbase::evbase(const std::string &name, unsigned prio)
     :pvt(new Pvt(name, prio))
     ,base(pvt->base.get())
 {}
 
-evbase::~evbase() {}
+evbase::~evbase()
+{
+    if(pvt->worker.isCurrentThread()) {
+        // Destroyed from one of our own callbacks.  eg. when it releases the last reference to our owner.
+        // Stop after the current callback, and let run() cleanup.
+        pvt->orphaned = true;
+        (void)event_base_loopbreak(pvt->base.get());
+        (void)pvt.release();
+    }
+}
 
 void evbase::sync()
 {
@@ -170,16 +334,7 @@ void evbase::sync()
 
 void evbase::dispatch(std::function<void()>&& fn)
 {
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), nullptr, nullptr);
-    }
-
-    timeval now{};
-    if(empty && event_add(pvt->dowork.get(), &now))
-        throw std::runtime_error("Unable to wakeup dispatch()");
+    pvt->push(std::move(fn), nullptr, nullptr);
 }
 
 void evbase::call(std::function<void()>&& fn)
@@ -191,16 +346,8 @@ void evbase::call(std::function<void()>&& fn)
 
     auto& done = call_done;
     std::exception_ptr result;
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), &result, &done);
-    }
 
-    timeval now{};
-    if(empty && event_add(pvt->dowork.get(), &now))
-        throw std::runtime_error("Unable to wakeup call()");
+    pvt->push(std::move(fn), &result, &done);
 
     done.wait();
     Guard G(pvt->lock);
@@ -322,6 +469,84 @@ void evsocket::mcast_iface(const SockAddr& iface) const
 
     // IPV6_MULTICAST_IF
 }
+#ifdef HAVE_MMSG
+// limit stack usage
+static constexpr size_t maxMMsg = 64u;
+#endif
+
+int evsocket::recvmmsg(mmsg* msgs, size_t n) const
+{
+#ifdef HAVE_MMSG
+    n = std::min(n, maxMMsg);
+    mmsghdr hdrs[maxMMsg];
+    iovec iovs[maxMMsg];
+
+    for(auto i : range(n)) {
+        msgs[i].addr = SockAddr();
+        iovs[i].iov_base = msgs[i].buf;
+        iovs[i].iov_len = msgs[i].len;
+        hdrs[i].msg_hdr = msghdr{};
+        hdrs[i].msg_hdr.msg_name = &msgs[i].addr->sa;
+        hdrs[i].msg_hdr.msg_namelen = msgs[i].addr.size();
+        hdrs[i].msg_hdr.msg_iov = &iovs[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1u;
+    }
+
+    int ret = ::recvmmsg(sock, hdrs, n, 0, nullptr);
+
+    for(auto i : range(std::max(ret, 0)))
+        msgs[i].len = hdrs[i].msg_len;
+
+    return ret;
+#else
+    size_t i;
+    for(i=0; i<n; i++) {
+        msgs[i].addr = SockAddr();
+        osiSocklen_t alen = msgs[i].addr.size();
+        int ret = recvfrom(sock, (char*)msgs[i].buf, msgs[i].len, 0, &msgs[i].addr->sa, &alen);
+        if(ret<0) {
+            if(i==0)
+                return -1;
+            break;
+        }
+        msgs[i].len = ret;
+    }
+    return int(i);
+#endif
+}
+
+int evsocket::sendmmsg(const mmsg* msgs, size_t n) const
+{
+#ifdef HAVE_MMSG
+    n = std::min(n, maxMMsg);
+    mmsghdr hdrs[maxMMsg];
+    iovec iovs[maxMMsg];
+
+    for(auto i : range(n)) {
+        iovs[i].iov_base = msgs[i].buf;
+        iovs[i].iov_len = msgs[i].len;
+        hdrs[i].msg_hdr = msghdr{};
+        hdrs[i].msg_hdr.msg_name = const_cast<sockaddr*>(&msgs[i].addr->sa);
+        hdrs[i].msg_hdr.msg_namelen = msgs[i].addr.size();
+        hdrs[i].msg_hdr.msg_iov = &iovs[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1u;
+    }
+
+    return ::sendmmsg(sock, hdrs, n, 0);
+#else
+    size_t i;
+    for(i=0; i<n; i++) {
+        int ret = sendto(sock, (char*)msgs[i].buf, msgs[i].len, 0, &msgs[i].addr->sa, msgs[i].addr.size());
+        if(ret<0) {
+            if(i==0)
+                return -1;
+            break;
+        }
+    }
+    return int(i);
+#endif
+}
+
 void to_wire(Buffer& buf, const SockAddr& val)
 {
     if(!buf.ensure(16)) {
@@ -374,6 +599,8 @@ void from_wire(Buffer &buf, SockAddr& val)
 
 bool Buffer::refill(size_t more) { return false; }
 
+bool Buffer::reference(const void *mem, size_t n, evbuffer_ref_cleanup_cb cleanup, void *extra) { return false; }
+
 FixedBuf::~FixedBuf() {}
 
 VectorOutBuf::~VectorOutBuf() {}
@@ -423,6 +650,15 @@ bool EvOutBuf::refill(size_t more)
     return true;
 }
 
+bool EvOutBuf::reference(const void *mem, size_t n, evbuffer_ref_cleanup_cb cleanup, void *extra)
+{
+    // commit any pending output first to preserve ordering
+    if(!refill(0))
+        return false;
+
+    return !evbuffer_add_reference(backing, mem, n, cleanup, extra);
+}
+
 EvInBuf::~EvInBuf() { refill(0); }
 
 bool EvInBuf::refill(size_t more)
@@ -436,9 +672,10 @@ bool EvInBuf::refill(size_t more)
     limit = base = pos = nullptr;
 
     if(more) {
-        // ensure new segment contains at least the requested size (one element)
+        // ensure new segment contains at least the requested size (one element),
+        // which includes any unconsumed bytes.
         // (we hope this is mostly a no-op)
-        (void)evbuffer_pullup(backing, len+more);
+        (void)evbuffer_pullup(backing, std::max(len, more));
 
         evbuffer_iovec vec;
 
@@ -451,7 +688,7 @@ bool EvInBuf::refill(size_t more)
         base = pos = (uint8_t*)vec.iov_base;
         limit = base+vec.iov_len;
 
-        if(size() < len+more) {
+        if(size() < more) {
             return false; // pullup didn't work.
         }
     }
@@ -59,6 +59,18 @@ struct owned_ptr : public std::unique_ptr<T>
     }
 };
 
+/* An event loop, and its worker thread.
+ *
+ * Usually destroyed from another thread, which waits for the worker to exit.
+ *
+ * May also be destroyed from one of its own callbacks, eg. when that callback
+ * releases the last reference to the owner.  Then ~evbase() returns immediately,
+ * and the worker deletes its own state after the current callback returns.
+ * Until then, the event_base remains valid.  Any remaining queued work is discarded
+ * without being run, and no further events are dispatched.  So the callback must not
+ * wait for other work queued to this evbase, and any events must be event_free()'d
+ * before it returns.
+ */
 struct PVXS_API evbase {
     explicit evbase(const std::string& name, unsigned prio=0);
     ~evbase();
@@ -132,6 +144,25 @@ struct PVXS_API evsocket
     //! Selects interface to use when sending mcasts
     //! @see IP_MULTICAST_IF
     void mcast_iface(const SockAddr& iface) const;
+
+    //! One datagram of a batch
+    struct mmsg {
+        //! source of received, or destination of sent, datagram
+        SockAddr addr;
+        void *buf;
+        //! Length to send.  When receiving, buffer size on entry and received length on success.
+        size_t len;
+    };
+    /** Receive up to n datagrams without blocking.
+     *  Uses recvmmsg() where available.
+     *  @returns number of datagrams received, or -1 on error (see evutil_socket_geterror()).
+     */
+    int recvmmsg(mmsg* msgs, size_t n) const;
+    /** Send up to n datagrams without blocking.
+     *  Uses sendmmsg() where available.
+     *  @returns number of datagrams sent, or -1 if the first could not be sent (see evutil_socket_geterror()).
+     */
+    int sendmmsg(const mmsg* msgs, size_t n) const;
 };
 
 }} // namespace pvxs::impl
@@ -8,6 +8,7 @@
 #define PVAPROTO_H
 
 #include <compilerDependencies.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <vector>
@@ -19,6 +20,12 @@
 
 #include <epicsEndian.h>
 
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSSE3__)
+#  include <tmmintrin.h>
+#endif
+
 #include <event2/buffer.h>
 #include <pvxs/version.h>
 
@@ -77,6 +84,12 @@ public:
     EPICS_ALWAYS_INLINE void _skip(size_t i) { pos+=i; }
 
     uint8_t* save() const { return pos; }
+
+    /** Append n bytes from mem without copying, if supported.
+     *  On success, cleanup(mem, n, extra) is called once the bytes are no longer needed.
+     *  Returns false, with no effect, if not supported.  Caller must then copy.
+     */
+    virtual bool reference(const void *mem, size_t n, evbuffer_ref_cleanup_cb cleanup, void *extra);
 };
 
 //! (de)serialization to/from buffers which are fixed size and contigious
@@ -126,6 +139,7 @@ public:
     {refill(isize);}
     virtual ~EvOutBuf();
     virtual bool refill(size_t more) override final;
+    virtual bool reference(const void *mem, size_t n, evbuffer_ref_cleanup_cb cleanup, void *extra) override final;
 };
 
 //! deserialize from an evbuffer, possibly segmented
@@ -187,6 +201,126 @@ inline void _from_wire(Buffer& buf, uint8_t *mem, bool reverse)
     buf._skip(N);
 }
 
+template<unsigned N> struct bswap;
+template<> struct bswap<1> {
+    typedef uint8_t type;
+    static inline type op(type v) { return v; }
+};
+template<> struct bswap<2> {
+    typedef uint16_t type;
+    static inline type op(type v) { return type(v>>8u) | type(v<<8u); }
+};
+template<> struct bswap<4> {
+    typedef uint32_t type;
+    static inline type op(type v) {
+        return (v>>24u) | ((v>>8u)&0xff00u) | ((v<<8u)&0xff0000u) | (v<<24u);
+    }
+};
+template<> struct bswap<8> {
+    typedef uint64_t type;
+    static inline type op(type v) {
+        return type(bswap<4>::op(uint32_t(v)))<<32u | bswap<4>::op(uint32_t(v>>32u));
+    }
+};
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+// shuffle control reversing each N byte element of a 16 byte lane
+template<unsigned N>
+inline __m128i _swap_mask()
+{
+    alignas(16) uint8_t mask[16];
+    for(unsigned i=0; i<16u; i++)
+        mask[i] = uint8_t(i - i%N + N-1 - i%N);
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+#endif
+
+/** Copy count elements, each of N bytes, from src to dst reversing the byte order of each.
+ *
+ * Whole vectors are swapped at a time where the target supports it (SSSE3 or AVX2),
+ * with a scalar loop for the remainder.  src and dst must not overlap.
+ */
+template<unsigned N>
+inline void _swap_array(uint8_t *dst, const uint8_t *src, size_t count)
+{
+    typedef typename bswap<N>::type elem_t;
+    size_t i = 0u;
+#if defined(__AVX2__)
+    {
+        auto mask(_mm256_broadcastsi128_si256(_swap_mask<N>()));
+        for(; i+32u/N <= count; i += 32u/N) {
+            auto v(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i*N)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i*N), _mm256_shuffle_epi8(v, mask));
+        }
+    }
+#elif defined(__SSSE3__)
+    {
+        auto mask(_swap_mask<N>());
+        for(; i+16u/N <= count; i += 16u/N) {
+            auto v(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*N)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*N), _mm_shuffle_epi8(v, mask));
+        }
+    }
+#endif
+    // memcpy() to avoid alignment assumptions.  Typically compiled as plain loads/stores
+    for(; i<count; i++) {
+        elem_t v;
+        memcpy(&v, src + i*N, N);
+        v = bswap<N>::op(v);
+        memcpy(dst + i*N, &v, N);
+    }
+}
+
+/** Read an array of count elements, each of N bytes, from buf into mem.
+ *
+ * Copies whole elements straight out of the backing buffer, byte swapping if reverse,
+ * refilling as necessary.
+ */
+template<unsigned N>
+inline void _from_wire_array(Buffer& buf, uint8_t *mem, size_t count, bool reverse)
+{
+    while(count) {
+        // an element split between segments will be pulled up
+        if(!buf.ensure(N)) {
+            buf.fault();
+            return;
+        }
+        size_t n = std::min(count, buf.size()/N);
+        if(N>1 && reverse)
+            _swap_array<N>(mem, buf.save(), n);
+        else
+            memcpy(mem, buf.save(), n*N);
+        buf._skip(n*N);
+        mem += n*N;
+        count -= n;
+    }
+}
+
+/** Write an array of count elements, each of N bytes, from mem into buf.
+ *
+ * Copies contiguous runs, byte swapping each element if reverse.
+ */
+template<unsigned N>
+inline void _to_wire_array(Buffer& buf, const uint8_t *mem, size_t count, bool reverse)
+{
+    while(count) {
+        // request a large contiguous region, but not necessarily all at once
+        if(!buf.ensure(std::min(count*N, size_t(0x10000u)))) {
+            buf.fault();
+            return;
+        }
+        // whole elements only
+        size_t n = std::min(count, buf.size()/N);
+        if(N>1 && reverse)
+            _swap_array<N>(buf.save(), mem, n);
+        else
+            memcpy(buf.save(), mem, n*N);
+        buf._skip(n*N);
+        mem += n*N;
+        count -= n;
+    }
+}
+
 /** Write sizeof(T) bytes from buf from val
  *
  * @param buf output buffer.  buf[0] through buf[sizeof(T)-1] must be valid.
@@ -94,7 +94,7 @@ class BitMask : public detail::BitBase<BitMask> {
     std::vector<uint64_t> _words;
     // actual size in bits
     // _words.size()*64u >= _size
-    uint8_t _size=0u;
+    size_t _size=0u;
 
 public:
 
@@ -170,13 +170,21 @@ private:
         friend BitMask;
         const BitMask* _mask = nullptr;
         size_t _bit = 0u;
+        size_t _end = 0u;
+        void _next() {
+            _bit=_mask->findSet(_bit+1);
+            if(_bit>_end)
+                _bit = _end;
+        }
     public:
         constexpr _SetIter() = default;
-        constexpr _SetIter(const BitMask* mask, size_t bit) :_mask(mask), _bit(bit) {}
+        constexpr _SetIter(const BitMask* mask, size_t bit, size_t end)
+            :_mask(mask), _bit(bit<end ? bit : end), _end(end)
+        {}
 
         size_t operator*() const { return _bit; }
-        _SetIter& operator++() { _bit=_mask->findSet(_bit+1); return *this; }
-        _SetIter operator++(int) { _SetIter ret{*this}; _bit=_mask->findSet(_bit+1); return ret;}
+        _SetIter& operator++() { _next(); return *this; }
+        _SetIter operator++(int) { _SetIter ret{*this}; _next(); return ret;}
 
         bool operator==(const _SetIter& o) { return _bit==o._bit; }
         bool operator!=(const _SetIter& o) { return _bit!=o._bit; }
@@ -188,8 +196,8 @@ private:
         constexpr explicit _OnlySet(const BitMask* mask, size_t a, size_t b) :_mask(mask), a(a), b(b) {}
     public:
         typedef _SetIter iterator;
-        iterator begin() const { return iterator{_mask, _mask->findSet(a)}; }
-        iterator end() const { return iterator{_mask, b}; }
+        iterator begin() const { return iterator{_mask, _mask->findSet(a), b}; }
+        iterator end() const { return iterator{_mask, b, b}; }
     };
 
 public:
@@ -251,9 +259,17 @@ inline bool operator!=(const BitMask& lhs, const BitMask& rhs) {
 namespace impl {
 struct Buffer;
 
+//! BitMask::findSet() of bits stored elsewhere.  words must hold at least nbits.
+PVXS_API
+size_t findSet(const uint64_t* words, size_t nbits, size_t start);
+
 PVXS_API
 void to_wire(Buffer& buf, const BitMask& mask);
 
+//! Serialize bits stored elsewhere, as for a BitMask
+PVXS_API
+void to_wire(Buffer& buf, const uint64_t* words, size_t nwords);
+
 PVXS_API
 void from_wire(Buffer& buf, BitMask& mask);
 }
@@ -143,6 +143,26 @@ struct PVXS_API Subscription {
      * @endcode
      */
     virtual Value pop() =0;
+
+    /** Return a Value previously pop()'d from this Subscription, which is no longer needed.
+     *
+     *  Up to queueSize Values are kept, and a later update may then be decoded into one
+     *  of them instead of allocating new storage.
+     *  Arrays which are no longer referenced elsewhere are also reused if an update
+     *  has the same length.
+     *  A Value, or array, still referenced elsewhere (eg. a copy, or a sub-field Value)
+     *  is simply released.
+     *
+     *  Fields not marked in a later update may hold the value of an earlier update.
+     *
+     * @code
+     * while(auto update = sub.pop()) {
+     *     ...
+     *     sub.recycle(std::move(update));
+     * }
+     * @endcode
+     */
+    virtual void recycle(Value&& val) =0;
 };
 
 class GetBuilder;
@@ -315,6 +335,9 @@ public:
      * - block     : bool
      * - process   : bool or string "true", "false", or "passive"
      * - pipeline  : bool
+     * - deadband  : number.  Monitor updates which change "value" by less are not sent.
+     * - maxRate   : number.  Maximum monitor updates per second.  Updates posted in between are squashed.
+     * - minPeriod : number.  Minimum seconds between monitor updates.
      *
      * A more efficient alternative to @code pvRequest("record[key=value]") @endcode
      */
@@ -467,6 +490,17 @@ struct PVXS_API Config {
     //! Whether to extend the addressList with local interface broadcast addresses.  (recommended)
     bool autoAddrList = true;
 
+    //! Number of worker threads among which server TCP connections are distributed.
+    //! Zero selects one worker per CPU core.  Default is 1.
+    unsigned tcp_workers = 1u;
+
+    //! Number of threads on which result() and event() callbacks are run.
+    //! Callbacks of one operation are always run in order, on the same thread.
+    //! Zero (the default) runs callbacks on the worker handling the server TCP connection,
+    //! where a slow callback delays processing of replies for all channels of that worker.
+    //! PutBuilder::build() callbacks are always run by a TCP worker.
+    unsigned callback_workers = 0u;
+
     //! Default configuration using process environment
     static Config from_env();
 
@@ -477,6 +511,7 @@ struct PVXS_API Config {
      *  expand() is provided as a aid to help understand how Context::effective() is arrived at.
      *
      *  @post autoAddrList==false
+     *  @post tcp_workers!=0
      */
     void expand();
 
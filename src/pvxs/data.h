@@ -319,6 +319,55 @@ struct PVXS_API NoConvert : public std::runtime_error
     virtual ~NoConvert();
 };
 
+/** Pre-resolved reference to a decendent field.
+ *
+ * Looks up a field name once, for a particular type.
+ * Applying it with Value::operator[] to a Value of this same type
+ * then costs about the same as copying a Value,
+ * without string parsing, map lookups, or memory allocation.
+ * Applying it to a Value of any other type does a normal name lookup.
+ *
+ * Type descriptions are shared process wide.  So Values of one type include
+ * those created by any TypeDef::create() with identical members,
+ * those received with an identical type over the network,
+ * and their Value::cloneEmpty() and Value::clone().
+ *
+ * @code
+ * Value proto = nt::NTScalar{TypeCode::Int32}.create();
+ * const FieldRef fvalue(proto, "value"), fsec(proto, "timeStamp.secondsPastEpoch");
+ * ...
+ * Value val(proto.cloneEmpty());
+ * val[fvalue] = 42;
+ * val[fsec] = time(nullptr);
+ * @endcode
+ */
+class PVXS_API FieldRef {
+    friend class Value;
+    // type against which this reference was resolved.  null if not resolved.
+    std::shared_ptr<const impl::FieldDesc> base;
+    // offset in the FieldDesc and FieldStorage arrays
+    size_t offset;
+    std::string expr;
+public:
+    //! Unresolved reference with an empty name
+    FieldRef() :offset(0u) {}
+    /** Resolve field name with respect to the type of proto.
+     *
+     * @param proto Value of the type against which name is resolved.
+     * @param name field name, as passed to Value::operator[]
+     *
+     * Paths which only consist of Struct member names (eg. "alarm.severity")
+     * are resolved.  Paths through a Union, Any, or array of Struct are not,
+     * and always fall back to name lookup.
+     */
+    FieldRef(const Value& proto, const std::string& name);
+
+    //! Field name
+    inline const std::string& name() const { return expr; }
+    //! Was name resolved to a field of the prototype type.
+    inline bool resolved() const { return base.operator bool(); }
+};
+
 /** Generic data container
  *
  * References a single data field, which may be free-standing (eg. "int x = 5;")
@@ -375,6 +424,21 @@ public:
     //! copy values from other.  Must have matching types.
     Value& assign(const Value&);
 
+    /** Unmark those marked fields whose value is the same as the corresponding field of prev.
+     *
+     * A marked Struct is treated as if each of its decendent fields were marked.
+     * Scalar and string fields are compared by value.
+     * Array fields are compared by reference, or if compareArrays, element by element.
+     * (arrays of Struct, Union, or Any are always compared by reference)
+     * Union and Any fields are compared by reference.
+     *
+     * @param prev Must have the same type as this.
+     * @param compareArrays When true, compare the contents of arrays which are not the same reference.
+     * @returns true if any field remains marked
+     * @throws std::runtime_error if types differ.
+     */
+    bool unmarkUnchanged(const Value& prev, bool compareArrays=false);
+
     //! Use to allocate members for an array of Struct and array of Union
     Value allocMember();
 
@@ -384,7 +448,8 @@ public:
 
     //! Test if this field is marked as valid/changed
     bool isMarked(bool parents=true, bool children=false) const;
-    //! Mark this field as valid/changed
+    //! Mark this field as valid/changed.
+    //! Different fields of one Value may be marked, or unmarked, from different threads.
     void mark(bool v=true);
     //! Remove mark from this field
     void unmark(bool parents=false, bool children=true);
@@ -537,6 +602,12 @@ public:
     inline Value operator[](const std::string& name) { return (*this)[name.c_str()]; }
     const Value operator[](const char *name) const;
     inline const Value operator[](const std::string& name) const { return (*this)[name.c_str()]; }
+    /** Access a decendant field through a pre-resolved reference.
+     *
+     * Equivalent to @code (*this)[ref.name()] @endcode
+     */
+    Value operator[](const FieldRef& ref);
+    const Value operator[](const FieldRef& ref) const;
 
     template<typename V>
     class Iterable;
@@ -94,6 +94,9 @@ public:
                       int order =0);
 
     //! Disassociate a Source using the name and priority given to addSource()
+    //!
+    //! @note A search or channel creation already in progress may still call
+    //!       the removed Source shortly after this returns.
     std::shared_ptr<Source> removeSource(const std::string& name,
                                          int order =0);
 
@@ -127,6 +130,21 @@ struct PVXS_API Config {
     unsigned short udp_port = 5076;
     //! Whether to populate the beacon address list automatically.  (recommended)
     bool auto_beacon = true;
+    //! Number of worker threads among which client TCP connections are distributed.
+    //! Zero selects one worker per CPU core.  Default is 1.
+    unsigned tcp_workers = 1u;
+    //! Number of threads on which Source and SharedPV callbacks are run.
+    //! Callbacks for one Channel are always run in order, on the same thread.
+    //! Zero (the default) runs callbacks on the worker handling the client TCP connection,
+    //! where a slow callback delays I/O for all channels of that worker.
+    //! Source::onSearch() and Source::onCreate() are always run by a server worker.
+    unsigned callback_workers = 0u;
+    //! Monitor updates with a body longer than this many bytes are sent after
+    //! any shorter updates which become ready at the same time on the same
+    //! client connection.  Bounds the delay of small updates sharing a connection
+    //! with large arrays.  The order of updates for one subscription is unchanged.
+    //! Zero disables.  Default is 64 KiB.
+    unsigned large_reply_size = 0x10000u;
 
     //! Server unique ID.  Only meaningful in readback via Server::config()
     std::array<uint8_t, 12> guid{};
@@ -145,6 +163,7 @@ struct PVXS_API Config {
      *  expand() is provided as a aid to help understand how Context::effective() is arrived at.
      *
      *  @post autoAddrList==false
+     *  @post tcp_workers!=0
      */
     void expand();
 
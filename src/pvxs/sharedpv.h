@@ -9,6 +9,9 @@
 
 #include <functional>
 #include <memory>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <pvxs/version.h>
 #include "srvcommon.h"
@@ -70,6 +73,18 @@ struct PVXS_API SharedPV
     //! Reverse the effects of open() and force disconnect any remaining clients.
     void close();
 
+    /** Control whether post() sends only those fields which have actually changed.
+     *
+     * When enabled, post() unmarks any marked field of the Value given which has
+     * the same value as the internal data value (cf. Value::unmarkUnchanged() ).
+     * An update in which no field remains marked is not sent to subscribers.
+     * Disabled by default.
+     *
+     * @param enable Enable change detection
+     * @param compareArrays Also compare the contents of arrays which are not the same reference.
+     */
+    void detectChanges(bool enable=true, bool compareArrays=false);
+
     //! Update the internal data value, and dispatch subscription updates to any clients.
     void post(Value&& val);
     //! query the internal data value.
@@ -97,9 +112,15 @@ struct PVXS_API StaticSource
     std::shared_ptr<Source> source() const;
 
     //! Add a new name through which a SharedPV may be addressed.
+    //! Each change copies the table of names.  Prefer add(map) to add many names.
     StaticSource& add(const std::string& name, const SharedPV& pv);
+    //! Add several names together.  Searches see either none or all of them.
+    //! No names are added if any is already present.
+    StaticSource& add(const std::map<std::string, SharedPV>& pvs);
     //! Remove a single name
     StaticSource& remove(const std::string& name);
+    //! Remove several names together.  Names not present are ignored.
+    StaticSource& remove(const std::vector<std::string>& names);
 
     struct Impl;
 private:
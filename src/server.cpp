@@ -30,6 +30,8 @@
 #include "utilpvt.h"
 #include "udp_collector.h"
 
+typedef epicsGuard<epicsMutex> Guard;
+
 namespace pvxs {
 namespace server {
 using namespace impl;
@@ -72,14 +74,24 @@ Server& Server::addSource(const std::string& name,
         throw std::logic_error("NULL Server");
     if(!src)
         throw std::logic_error(SB()<<"Attempt to add NULL Source "<<name<<" at "<<order);
-    {
-        auto G(pvt->sourcesLock.lockWriter());
 
-        auto& ent = pvt->sources[std::make_pair(order, name)];
+    // before sourcesLock, which the watcher takes
+    pvt->watch(src.get());
+    try {
+        Guard G(pvt->sourcesLock);
+
+        auto next(std::make_shared<Pvt::sources_t>(*pvt->sources.load()));
+
+        auto& ent = (*next)[std::make_pair(order, name)];
         if(ent)
             throw std::runtime_error(SB()<<"Source already registered : ("<<name<<", "<<order<<")");
         ent = src;
+        pvt->sources.store(std::move(next));
+        pvt->updateSearchIndex();
         pvt->beaconChange++;
+    } catch(...) {
+        pvt->unwatch(src.get());
+        throw;
     }
     return *this;
 }
@@ -89,15 +101,23 @@ std::shared_ptr<Source> Server::removeSource(const std::string& name,  int order
     if(!pvt)
         throw std::logic_error("NULL Server");
 
-    auto G(pvt->sourcesLock.lockWriter());
-
     std::shared_ptr<Source> ret;
-    auto it = pvt->sources.find(std::make_pair(order, name));
-    if(it!=pvt->sources.end()) {
-        ret = it->second;
-        pvt->sources.erase(it);
+    {
+        Guard G(pvt->sourcesLock);
+
+        auto next(std::make_shared<Pvt::sources_t>(*pvt->sources.load()));
+        auto it = next->find(std::make_pair(order, name));
+        if(it!=next->end()) {
+            ret = it->second;
+            next->erase(it);
+            pvt->sources.store(std::move(next));
+            pvt->updateSearchIndex();
+        }
+        pvt->beaconChange++;
     }
-    pvt->beaconChange++;
+
+    if(ret)
+        pvt->unwatch(ret.get());
 
     return ret;
 }
@@ -107,11 +127,11 @@ std::shared_ptr<Source> Server::getSource(const std::string& name, int order)
     if(!pvt)
         throw std::logic_error("NULL Server");
 
-    auto G(pvt->sourcesLock.lockReader());
+    auto srcs(pvt->sources.load());
 
     std::shared_ptr<Source> ret;
-    auto it = pvt->sources.find(std::make_pair(order, name));
-    if(it!=pvt->sources.end()) {
+    auto it = srcs->find(std::make_pair(order, name));
+    if(it!=srcs->end()) {
         ret = it->second;
     }
 
@@ -125,11 +145,11 @@ void Server::listSource(std::vector<std::pair<std::string, int> > &names)
 
     names.clear();
 
-    auto G(pvt->sourcesLock.lockReader());
+    auto srcs(pvt->sources.load());
 
-    names.reserve(pvt->sources.size());
+    names.reserve(srcs->size());
 
-    for(auto& pair : pvt->sources) {
+    for(auto& pair : *srcs) {
         names.emplace_back(pair.first.second, pair.first.first);
     }
 }
@@ -230,6 +250,16 @@ Server::Pvt::Pvt(const Config &conf)
 {
     effective.expand();
 
+    workers.reserve(effective.tcp_workers);
+    for(auto i : range(effective.tcp_workers)) {
+        workers.emplace_back(new evbase(SB()<<"PVXTCP"<<i, epicsThreadPriorityCAServerLow-2));
+    }
+
+    callbackWorkers.reserve(effective.callback_workers);
+    for(auto i : range(effective.callback_workers)) {
+        callbackWorkers.emplace_back(new evbase(SB()<<"PVXCB"<<i, epicsThreadPriorityCAServerLow-3));
+    }
+
     {
         int val = 1;
         if(setsockopt(beaconSender.sock, SOL_SOCKET, SO_BROADCAST, (char *)&val, sizeof(val)))
@@ -318,15 +348,41 @@ Server::Pvt::Pvt(const Config &conf)
 
     // Add magic "server" PV
     {
-        auto L = sourcesLock.lockWriter();
-        sources[std::make_pair(-1, "server")] = std::make_shared<ServerSource>(this);
-        sources[std::make_pair(-1, "builtin")] = builtinsrc.source();
+        auto initial(std::make_shared<sources_t>());
+        (*initial)[std::make_pair(-1, "server")] = std::make_shared<ServerSource>(this);
+        (*initial)[std::make_pair(-1, "builtin")] = builtinsrc.source();
+        sources.store(std::move(initial));
+    }
+
+    watch(builtinsrc.source().get());
+    {
+        Guard G(sourcesLock);
+        updateSearchIndex();
     }
 }
 
 Server::Pvt::~Pvt()
 {
     stop();
+
+    for(auto& pair : *sources.load())
+        unwatch(pair.second.get());
+}
+
+void Server::Pvt::watch(Source* src)
+{
+    if(auto list = dynamic_cast<WatchedList*>(src)) {
+        list->watch(this, [this]() {
+            Guard G(sourcesLock);
+            updateSearchIndex();
+        });
+    }
+}
+
+void Server::Pvt::unwatch(Source* src)
+{
+    if(auto list = dynamic_cast<WatchedList*>(src))
+        list->unwatch(this);
 }
 
 void Server::Pvt::start()
@@ -410,14 +466,32 @@ void Server::Pvt::stop()
             }
             log_debug_printf(serversetup, "Server disabled listener on %s\n", iface.name.c_str());
         }
+    });
 
-        // close current TCP connections
-        auto conns = std::move(connections);
-        for(auto& pair : conns) {
-            pair.second->bev.reset();
-            pair.second->cleanup();
+    // flush out connections accepted, but not yet setup
+    for(auto& worker : workers) {
+        worker->sync();
+    }
+
+    // close current TCP connections.
+    // each on its own worker, where cleanup() removes from connections
+    std::vector<std::shared_ptr<ServerConn>> conns;
+    {
+        Guard G(connectionsLock);
+        conns.reserve(connections.size());
+        for(auto& pair : connections) {
+            conns.push_back(pair.second);
         }
+    }
+    for(auto& conn : conns) {
+        conn->loop.call([&conn]() {
+            conn->bev.reset();
+            conn->cleanup();
+        });
+    }
 
+    acceptor_loop.call([this]()
+    {
         state = Stopped;
     });
 }
@@ -434,17 +508,7 @@ void Server::Pvt::onSearch(const UDPManager::Search& msg)
         searchOp._names[i]._claim = false;
     }
 
-    {
-        auto G(sourcesLock.lockReader());
-        for(const auto& pair : sources) {
-            try {
-                pair.second->onSearch(searchOp);
-            }catch(std::exception& e){
-                log_err_printf(serversetup, "Unhandled error in Source::onSearch for '%s' : %s\n",
-                           pair.first.second.c_str(), e.what());
-            }
-        }
-    }
+    searchSources(searchOp);
 
     uint16_t nreply = 0;
     for(const auto& name : searchOp._names) {
@@ -489,6 +553,79 @@ void Server::Pvt::onSearch(const UDPManager::Search& msg)
     }
 }
 
+void Server::Pvt::updateSearchIndex()
+{
+    auto index(std::make_shared<SearchIndex>());
+    index->sources = sources.load();
+    std::vector<std::shared_ptr<const std::set<std::string>>> lists;
+    size_t nnames = 0u;
+
+    for(const auto& pair : *index->sources) {
+        Source::List list{};
+        // a Source which may add names without telling us can't be indexed
+        if(dynamic_cast<const WatchedList*>(pair.second.get())) {
+            try {
+                list = pair.second->onList();
+            }catch(std::exception& e){
+                log_err_printf(serversetup, "Unhandled error in Source::onList for '%s' : %s\n",
+                           pair.first.second.c_str(), e.what());
+            }
+        }
+
+        if(list.names && !list.dynamic) {
+            nnames += list.names->size();
+            lists.push_back(list.names);
+
+        } else {
+            index->unindexed.emplace_back(pair.first.second, pair.second);
+        }
+    }
+
+    index->names.reset(new NameIndex(nnames));
+    for(auto& list : lists) {
+        for(auto& name : *list)
+            index->names->insert(name);
+    }
+
+    log_debug_printf(serversetup, "Search index of %zu names, %zu unindexed sources\n",
+                     nnames, index->unindexed.size());
+
+    searchIndex.store(std::move(index));
+}
+
+void Server::Pvt::searchSources(Source::Search& op)
+{
+    auto index(searchIndex.load());
+
+    bool listed = false;
+    for(const auto& name : op._names) {
+        if(index->names->contains(name._name)) {
+            listed = true;
+            break;
+        }
+    }
+
+    auto search = [&op](const std::string& name, Source* src) {
+        try {
+            src->onSearch(op);
+        }catch(std::exception& e){
+            log_err_printf(serversetup, "Unhandled error in Source::onSearch for '%s' : %s\n",
+                       name.c_str(), e.what());
+        }
+    };
+
+    if(listed) {
+        // preserve Source order
+        for(const auto& pair : *index->sources)
+            search(pair.first.second, pair.second.get());
+
+    } else {
+        // none of the names are listed by a static Source
+        for(const auto& pair : index->unindexed)
+            search(pair.first, pair.second.get());
+    }
+}
+
 void Server::Pvt::doBeacons(short evt)
 {
     log_debug_printf(serversetup, "Server beacon timer expires\n%s", "");
@@ -515,8 +652,15 @@ void Server::Pvt::doBeacons(short evt)
 
     assert(M.good() && H.good());
 
-    for(const auto& dest : beaconDest) {
-        int ntx = sendto(beaconSender.sock, (char*)beaconMsg.data(), pktlen, 0, &dest->sa, dest.size());
+    beaconTxMsgs.resize(beaconDest.size());
+    for(auto i : range(beaconDest.size())) {
+        beaconTxMsgs[i].addr = beaconDest[i];
+        beaconTxMsgs[i].buf = beaconMsg.data();
+        beaconTxMsgs[i].len = pktlen;
+    }
+
+    for(size_t i=0; i<beaconTxMsgs.size(); ) {
+        int ntx = beaconSender.sendmmsg(&beaconTxMsgs[i], beaconTxMsgs.size()-i);
 
         if(ntx<0) {
             int err = evutil_socket_geterror(beaconSender.sock);
@@ -525,13 +669,12 @@ void Server::Pvt::doBeacons(short evt)
                 lvl = Level::Debug;
             log_printf(serverio, lvl, "Beacon tx error (%d) %s\n",
                        err, evutil_socket_error_to_string(err));
-
-        } else if(unsigned(ntx)<pktlen) {
-            log_warn_printf(serverio, "Beacon truncated %u < %u",
-                       unsigned(ntx), unsigned(pktlen));
+            i++; // skip this destination
 
         } else {
-            log_debug_printf(serverio, "Beacon tx to %s\n", dest.tostring().c_str());
+            for(auto end = i+size_t(ntx); i<end; i++) {
+                log_debug_printf(serverio, "Beacon tx to %s\n", beaconDest[i].tostring().c_str());
+            }
         }
     }
 
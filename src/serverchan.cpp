@@ -12,6 +12,8 @@
 
 namespace pvxs {namespace impl {
 
+typedef epicsGuard<epicsMutex> Guard;
+
 // message related to client state and errors
 DEFINE_LOGGER(connsetup, "pvxs.tcp.setup");
 // related to low level send/recv
@@ -28,12 +30,32 @@ ServerChan::ServerChan(const std::shared_ptr<ServerConn> &conn,
     ,cid(cid)
     ,name(name)
     ,state(Creating)
+    ,executor([&conn]() -> evbase* {
+        auto& pool = conn->iface->server->callbackWorkers;
+        if(pool.empty())
+            return nullptr;
+        return pool[conn->iface->server->nextCallbackWorker++ % pool.size()].get();
+    }())
 {}
 
 ServerChan::~ServerChan() {}
 
+void ServerChan::callback(std::function<void()>&& fn, bool later)
+{
+    if(executor) {
+        executor->dispatch(std::move(fn));
+
+    } else if(!later) {
+        fn();
+
+    } else if(auto c = conn.lock()) {
+        c->loop.dispatch(std::move(fn));
+    }
+}
+
 ServerChannelControl::ServerChannelControl(const std::shared_ptr<ServerConn> &conn, const std::shared_ptr<ServerChan>& channel)
     :server(conn->iface->server->internal_self)
+    ,loop(conn->loop)
     ,chan(channel)
 {
     _op = None;
@@ -50,7 +72,7 @@ void ServerChannelControl::onOp(std::function<void(std::unique_ptr<server::Conne
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -65,11 +87,12 @@ void ServerChannelControl::onRPC(std::function<void(std::unique_ptr<server::Exec
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
 
+        Guard G(ch->lock);
         ch->onRPC = std::move(fn);
     });
 }
@@ -80,7 +103,7 @@ void ServerChannelControl::onSubscribe(std::function<void(std::unique_ptr<server
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -95,7 +118,7 @@ void ServerChannelControl::onClose(std::function<void(const std::string&)>&& fn)
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -124,12 +147,14 @@ void ServerChannel_shutdown(const std::shared_ptr<ServerChan>& chan)
             continue;
 
         if(op->state==ServerOp::Executing && op->onCancel)
-            op->onCancel();
+            chan->callback(std::function<void()>(op->onCancel));
 
         op->state = ServerOp::Dead;
 
-        if(op->onClose)
-            op->onClose("");
+        if(auto cb = op->onClose)
+            chan->callback([cb]() {
+                cb("");
+            });
 
         conn->opByIOID.erase(op->ioid);
     }
@@ -144,7 +169,7 @@ void ServerChannelControl::close()
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this](){
+    loop.call([this](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -204,17 +229,7 @@ void ServerConn::handle_SEARCH()
     if(!M.good())
         throw std::runtime_error("TCP Search decode error");
 
-    {
-        auto G(iface->server->sourcesLock.lockReader());
-        for(const auto& pair : iface->server->sources) {
-            try {
-                pair.second->onSearch(op);
-            }catch(std::exception& e){
-                log_err_printf(serversetup, "Unhandled error in Source::onSearch for '%s' : %s\n",
-                           pair.first.second.c_str(), e.what());
-            }
-        }
-    }
+    iface->server->searchSources(op);
 
     uint16_t nreply = 0;
     for(const auto& name : op._names) {
@@ -253,7 +268,7 @@ void ServerConn::handle_CREATE_CHANNEL()
 
     EvInBuf M(peerBE, segBuf.get(), 16);
 
-    auto G(iface->server->sourcesLock.lockReader());
+    auto srcs(iface->server->sources.load());
 
     // one channel create request contains main channel names.
     // each of which will received a seperate reply.
@@ -287,7 +302,7 @@ void ServerConn::handle_CREATE_CHANNEL()
             auto chan(std::make_shared<ServerChan>(self, sid, cid, name));
             std::unique_ptr<server::ChannelControl> op(new ServerChannelControl(self, chan));
 
-            for(auto& pair : iface->server->sources) {
+            for(auto& pair : *srcs) {
                 try {
                     pair.second->onCreate(std::move(op));
                     if(!op || chan->onOp || chan->onClose || chan->state!=ServerChan::Creating) {
@@ -15,8 +15,7 @@
 #include <pvxs/log.h>
 #include "serverconn.h"
 
-// limit on size of TX buffer above which we suspend RX
-static constexpr size_t tcp_tx_limit = 0x100000;
+typedef epicsGuard<epicsMutex> Guard;
 
 namespace pvxs {namespace impl {
 
@@ -27,17 +26,23 @@ DEFINE_LOGGER(connio, "pvxs.tcp.io");
 
 DEFINE_LOGGER(remote, "pvxs.remote.log");
 
-ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen)
+ServerConn::ServerConn(ServIface* iface, evbase& loop, evutil_socket_t sock, const SockAddr& peer)
     :ConnBase(false,
-              bufferevent_socket_new(iface->server->acceptor_loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
-              SockAddr(peer, socklen))
+              bufferevent_socket_new(loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
+              peer)
     ,iface(iface)
+    ,loop(loop)
     ,nextSID(0)
+    ,monReady(std::make_shared<MonitorReady>(this))
 {
+    loop.assertInLoop();
+
     log_debug_printf(connio, "Client %s connects\n", peerName.c_str());
 
     bufferevent_setcb(bev.get(), &bevReadS, &bevWriteS, &bevEventS, this);
 
+    txLarge = iface->server->effective.large_reply_size;
+
     timeval timo = {30, 0};
     bufferevent_set_timeouts(bev.get(), &timo, &timo);
 
@@ -80,7 +85,12 @@ ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *
 }
 
 ServerConn::~ServerConn()
-{}
+{
+    decltype (monReady->ops) trash; // destroyed after unlock
+    Guard G(monReady->lock);
+    monReady->conn = nullptr;
+    trash.swap(monReady->ops);
+}
 
 const std::shared_ptr<ServerChan>& ServerConn::lookupSID(uint32_t sid)
 {
@@ -198,7 +208,7 @@ void ServerConn::handle_CANCEL_REQUEST()
         op->state = ServerOp::Idle;
 
         if(op->onCancel)
-            op->onCancel();
+            chan->callback(std::function<void()>(op->onCancel));
 
     } else {
         // an allowed race
@@ -230,8 +240,10 @@ void ServerConn::handle_DESTROY_REQUEST()
         opByIOID.erase(it);
         op->state = ServerOp::Dead;
 
-        if(op->onClose)
-            op->onClose("");
+        if(auto cb = op->onClose)
+            chan->callback([cb]() {
+                cb("");
+            });
     }
 }
 
@@ -280,18 +292,33 @@ void ServerConn::cleanup()
 {
     log_debug_printf(connsetup, "Client %s Cleanup TCP Connection\n", peerName.c_str());
 
-    auto it = iface->server->connections.find(this);
-    if(it!=iface->server->connections.end()) {
-        auto self = std::move(it->second);
-        iface->server->connections.erase(it);
+    std::shared_ptr<ServerConn> self;
+    {
+        Guard G(iface->server->connectionsLock);
+        auto it = iface->server->connections.find(this);
+        if(it!=iface->server->connections.end()) {
+            self = std::move(it->second);
+            iface->server->connections.erase(it);
+        }
+    }
 
+    if(self) {
         for(auto& pair : self->opByIOID) {
-            if(pair.second->onClose)
-                pair.second->onClose("");
+            auto cb = pair.second->onClose;
+            if(!cb)
+                continue;
+            if(auto chan = pair.second->chan.lock())
+                chan->callback([cb]() {
+                    cb("");
+                });
+            else
+                cb("");
         }
         for(auto& pair : self->chanBySID) {
-            if(pair.second->onClose)
-                pair.second->onClose("");
+            if(auto cb = pair.second->onClose)
+                pair.second->callback([cb]() {
+                    cb("");
+                });
         }
 
         // delete this
@@ -315,18 +342,28 @@ void ServerConn::bevRead()
     }
 }
 
+bool ServerConn::txReady() const
+{
+    return bev
+            && (bufferevent_get_enabled(bev.get())&EV_READ)
+            && evbuffer_get_length(bufferevent_get_output(bev.get()))<tcp_tx_limit;
+}
+
 void ServerConn::bevWrite()
 {
     log_debug_printf(connio, "%s process backlog\n", peerName.c_str());
 
     auto tx = bufferevent_get_output(bev.get());
     // handle pending monitors
+    {
+        HoldTx H(*this);
 
-    while(!backlog.empty() && evbuffer_get_length(tx)<tcp_tx_limit) {
-        auto fn = std::move(backlog.front());
-        backlog.pop_front();
+        while(!backlog.empty() && evbuffer_get_length(tx)<tcp_tx_limit) {
+            auto fn = std::move(backlog.front());
+            backlog.pop_front();
 
-        fn();
+            fn();
+        }
     }
 
     // TODO configure
@@ -374,8 +411,21 @@ void ServIface::onConnS(struct evconnlistener *listener, evutil_socket_t sock, s
             evutil_closesocket(sock);
             return;
         }
-        auto conn(std::make_shared<ServerConn>(self, sock, peer, socklen));
-        self->server->connections[conn.get()] = std::move(conn);
+        auto serv = self->server;
+        auto& worker = *serv->workers[serv->nextWorker++ % serv->workers.size()];
+        SockAddr peerAddr(peer, socklen);
+
+        // setup connection on its worker.  From here on, we don't touch it.
+        worker.dispatch([self, serv, &worker, sock, peerAddr]() {
+            try {
+                auto conn(std::make_shared<ServerConn>(self, worker, sock, peerAddr));
+                Guard G(serv->connectionsLock);
+                serv->connections[conn.get()] = std::move(conn);
+            }catch(std::exception& e){
+                log_crit_printf(connsetup, "Interface %s Unhandled error in connection setup: %s\n", self->name.c_str(), e.what());
+                evutil_closesocket(sock);
+            }
+        });
     }catch(std::exception& e){
         log_crit_printf(connsetup, "Interface %s Unhandled error in accept callback: %s\n", self->name.c_str(), e.what());
         evutil_closesocket(sock);
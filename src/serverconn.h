@@ -9,10 +9,12 @@
 
 #include <list>
 #include <map>
+#include <unordered_set>
 #include <memory>
 #include <atomic>
 
 #include <epicsEvent.h>
+#include <epicsMutex.h>
 
 #include <pvxs/server.h>
 #include <pvxs/source.h>
@@ -66,6 +68,8 @@ struct ServerChannelControl : public server::ChannelControl
     virtual void close() override final;
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // worker of the owning ServerConn.  Only access while server.lock() succeeds
+    evbase& loop;
     const std::weak_ptr<ServerChan> chan;
 };
 
@@ -83,21 +87,81 @@ struct ServerChan
     } state;
 
     std::function<void(std::unique_ptr<server::ConnectOp>&&)> onOp;
+    // guards onRPC, which is read from the executor
+    epicsMutex lock;
     std::function<void(std::unique_ptr<server::ExecOp>&&, Value&&)> onRPC;
     std::function<void(std::unique_ptr<server::MonitorSetupOp>&&)> onSubscribe;
     std::function<void(const std::string&)> onClose;
 
     std::map<uint32_t, std::shared_ptr<ServerOp> > opByIOID; // our subset of ServerConn::opByIOID
 
+    // runs user callbacks for this channel, in order.  NULL when Config::callback_workers==0
+    evbase* const executor;
+
     ServerChan(const std::shared_ptr<ServerConn>& conn, uint32_t sid, uint32_t cid, const std::string& name);
     ServerChan(const ServerChan&) = delete;
     ServerChan& operator=(const ServerChan&) = delete;
     ~ServerChan();
+
+    /* Run a user callback on our executor.
+     * Without an executor, run it now, or if later==true after the current event
+     * on the connection worker.
+     * fn must not access ServerChan, ServerConn, or ServerOp members,
+     * which belong to the connection worker, except those guarded by a lock.
+     */
+    void callback(std::function<void()>&& fn, bool later=false);
+};
+
+/* Operations with replies ready to send, drained by the connection worker in one pass.
+ * cf. MonitorOp::maybeReply()
+ * Shared by a ServerConn and its operations, which may be accessed from any thread.
+ */
+struct MonitorReady
+{
+    epicsMutex lock;
+    // cleared by ~ServerConn()
+    ServerConn* conn;
+    std::vector<std::shared_ptr<ServerOp>> ops;
+
+    explicit MonitorReady(ServerConn* conn) :conn(conn) {}
+};
+
+/* One update from SharedPV::post() queued to several subscriptions.
+ * val is not modified once shared.  Subscriptions with the same
+ * field mask share one serialization.  cf. MonitorOp::doReply()
+ */
+struct SharedUpdate
+{
+    // immutable once encoded.  may contain references to array storage.
+    typedef std::shared_ptr<const evbuf> bytes_t;
+
+    const Value val;
+
+    explicit SharedUpdate(const Value& val) :val(val) {}
+
+    // serialize val, or return an earlier serialization with the same mask.
+    // May be called concurrently.
+    bytes_t encode(const BitMask& mask);
+
+private:
+    epicsMutex lock;
+    // usually one entry
+    std::list<std::pair<BitMask, bytes_t>> encoded;
+};
+
+// A subscription which can accept a SharedUpdate.  cf. SharedPV::post()
+struct SharedUpdateSink
+{
+    virtual ~SharedUpdateSink() {}
+    // equivalent to MonitorControlOp::post(Value(update->val))
+    virtual bool postShared(const std::shared_ptr<SharedUpdate>& update) =0;
 };
 
 struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerConn>
 {
     ServIface* const iface;
+    // worker which owns our bufferevent.  All members may only be accessed from this loop.
+    evbase& loop;
 
     // credentials
 
@@ -106,8 +170,12 @@ struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerC
     std::map<uint32_t, std::shared_ptr<ServerOp> > opByIOID;
 
     std::list<std::function<void()>> backlog;
+    // May another reply be queued now?  Otherwise add to backlog.
+    bool txReady() const;
+
+    const std::shared_ptr<MonitorReady> monReady;
 
-    ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen);
+    ServerConn(ServIface* iface, evbase& loop, evutil_socket_t sock, const SockAddr& peer);
     ServerConn(const ServerConn&) = delete;
     ServerConn& operator=(const ServerConn&) = delete;
     ~ServerConn();
@@ -178,6 +246,21 @@ struct ServerSource : public server::Source
     virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final;
 };
 
+/* Set of names, with a Bloom filter which rejects most absent names
+ * before hashing and comparing strings.
+ */
+struct NameIndex {
+    explicit NameIndex(size_t nexpect);
+
+    void insert(const std::string& name);
+    bool contains(const char *name) const;
+
+private:
+    std::vector<uint64_t> bloom;
+    uint64_t nbits;
+    std::unordered_set<std::string> names;
+};
+
 } // namespace impl
 
 namespace server {
@@ -201,13 +284,28 @@ struct Server::Pvt
     // accept new connections and send beacons
     evbase acceptor_loop;
 
+    // handle client TCP connections.  Each ServerConn is bound to one worker
+    std::vector<std::unique_ptr<evbase>> workers;
+    // round-robin selection of worker for next connection.  only access from acceptor worker
+    size_t nextWorker = 0u;
+
+    // run Source callbacks when Config::callback_workers!=0.  Each ServerChan is bound to one.
+    // destroyed before workers
+    std::vector<std::unique_ptr<evbase>> callbackWorkers;
+    // round-robin selection of callback worker for next channel
+    std::atomic<size_t> nextCallbackWorker{0u};
+
     std::list<std::unique_ptr<UDPListener> > listeners;
     std::vector<SockAddr> beaconDest;
 
     std::list<ServIface> interfaces;
+
+    // ServerConn are added/removed from their worker.  protected by connectionsLock
+    epicsMutex connectionsLock;
     std::map<ServerConn*, std::shared_ptr<ServerConn> > connections;
 
     evsocket beaconSender;
+    std::vector<evsocket::mmsg> beaconTxMsgs;
     evevent beaconTimer;
 
     std::vector<uint8_t> searchReply;
@@ -216,8 +314,23 @@ struct Server::Pvt
 
     StaticSource builtinsrc;
 
-    RWLock sourcesLock;
-    std::map<std::pair<int, std::string>, std::shared_ptr<Source> > sources;
+    typedef std::map<std::pair<int, std::string>, std::shared_ptr<Source> > sources_t;
+    // serializes changes to sources
+    epicsMutex sourcesLock;
+    // current Sources.  Readers do not lock.
+    SnapshotPtr<sources_t> sources;
+
+    // Names of all Sources which provide a static list
+    struct SearchIndex {
+        // the Sources from which this index was built
+        std::shared_ptr<const sources_t> sources;
+        std::unique_ptr<NameIndex> names;
+        // Sources which may claim names not in the index.  In order.
+        std::vector<std::pair<std::string, std::shared_ptr<Source>>> unindexed;
+    };
+    // Rebuilt by writers after each change to sources, or to the list of a WatchedList
+    // among them.  Readers do not lock.
+    SnapshotPtr<SearchIndex> searchIndex;
 
     enum state_t {
         Stopped,
@@ -232,6 +345,16 @@ struct Server::Pvt
     void start();
     void stop();
 
+    // call Source::onSearch() of those Sources which may claim one of the names.
+    void searchSources(Source::Search& op);
+
+    // caller must hold sourcesLock
+    void updateSearchIndex();
+    // update search index after each change to the list of src, if a WatchedList.
+    // caller must not hold sourcesLock
+    void watch(Source* src);
+    void unwatch(Source* src);
+
 private:
     void onSearch(const UDPManager::Search& msg);
     void doBeacons(short evt);
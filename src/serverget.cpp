@@ -12,6 +12,7 @@
 #include "pvrequest.h"
 
 namespace pvxs { namespace impl {
+typedef epicsGuard<epicsMutex> Guard;
 DEFINE_LOGGER(connsetup, "pvxs.tcp.setup");
 DEFINE_LOGGER(connio, "pvxs.tcp.io");
 
@@ -83,7 +84,7 @@ struct ServerGPR : public ServerOp
             } else if(state==Creating) {
                 // connect()
                 if(cmd!=CMD_RPC) {
-                    to_wire(R, type.get());
+                    to_wire(R, type, conn->txRegistry);
                 }
                 state = Idle;
 
@@ -92,8 +93,7 @@ struct ServerGPR : public ServerOp
                     to_wire_valid(R, value, &pvMask); // GET and PUT/Get reply with bitmask and partial value
 
                 } else if(cmd==CMD_RPC) {
-                    auto type = Value::Helper::desc(value);
-                    to_wire(R, type);
+                    to_wire(R, Value::Helper::type(value), conn->txRegistry);
                     if(value)
                         to_wire_full(R, value);
                 }
@@ -114,10 +114,10 @@ struct ServerGPR : public ServerOp
                 auto self(it->second);
                 conn->opByIOID.erase(it);
 
-                if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
-                        self->onClose("");
-                    });
+                if(auto cb = self->onClose)
+                    ch->callback([cb](){
+                        cb("");
+                    }, true);
 
             } else {
                 assert(false); // really shouldn't happen
@@ -133,6 +133,8 @@ struct ServerGPR : public ServerOp
     std::shared_ptr<const FieldDesc> type;
     BitMask pvMask; // mask computed from pvRequest .fields
 
+    // guards onPut and onGet, which are read from the executor
+    epicsMutex lock;
     std::function<void(std::unique_ptr<server::ExecOp>&&, Value&&)> onPut;
 
     std::function<void(std::unique_ptr<server::ExecOp>&&)> onGet;
@@ -147,6 +149,7 @@ struct ServerGPRConnect : public server::ConnectOp
                      const Value& request,
                      const std::weak_ptr<ServerGPR>& op)
         :server(server)
+        ,loop(conn->loop)
         ,op(op)
     {
         _op = Info;
@@ -164,7 +167,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &prototype](){
+        loop.call([this, &prototype](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
@@ -191,7 +194,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating)
                     oper->doReply(Value(), msg);
@@ -204,9 +207,11 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
-            if(auto oper = op.lock())
+        loop.call([this, &fn](){
+            if(auto oper = op.lock()) {
+                Guard G(oper->lock);
                 oper->onGet = std::move(fn);
+            }
         });
     }
     virtual void onPut(std::function<void(std::unique_ptr<server::ExecOp>&&, Value&&)>&& fn) override final
@@ -214,9 +219,11 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
-            if(auto oper = op.lock())
+        loop.call([this, &fn](){
+            if(auto oper = op.lock()) {
+                Guard G(oper->lock);
                 oper->onPut = std::move(fn);
+            }
         });
     }
     virtual void onClose(std::function<void(const std::string&)>&& fn) override final
@@ -224,13 +231,14 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    evbase& loop;
     const std::weak_ptr<ServerGPR> op;
 };
 
@@ -242,6 +250,7 @@ struct ServerGPRExec : public server::ExecOp
                      const Value& request,
                      const std::weak_ptr<ServerGPR>& op)
         :server(server)
+        ,loop(conn->loop)
         ,op(op)
     {
         _op = Info;
@@ -261,7 +270,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &val](){
+        loop.call([this, &val](){
             if(auto oper = op.lock()) {
                 oper->doReply(val, std::string());
             }
@@ -275,7 +284,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 oper->doReply(Value(), msg);
             }
@@ -287,13 +296,14 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onCancel = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    evbase& loop;
     const std::weak_ptr<ServerGPR> op;
 };
 
@@ -354,8 +364,11 @@ void ServerConn::handle_GPR(pva_app_msg_t cmd)
         if(cmd==CMD_RPC) {
             ctrl->connect(Value());
 
-        } else if(chan->onOp) { // GET, PUT
-            chan->onOp(std::move(ctrl));
+        } else if(auto cb = chan->onOp) { // GET, PUT
+            auto pctrl(std::make_shared<std::unique_ptr<ServerGPRConnect>>(std::move(ctrl)));
+            chan->callback([cb, pctrl]() {
+                cb(std::move(*pctrl));
+            });
 
         } else {
             ctrl->error("Get/Put/RPC not implemented for this PV");
@@ -412,42 +425,69 @@ void ServerConn::handle_GPR(pva_app_msg_t cmd)
             if(!op->lastRequest)
                 op->lastRequest = subcmd&0x10;
 
-            std::unique_ptr<ServerGPRExec> ctrl{new ServerGPRExec(this, iface->server->internal_self, chan->name, val, op)};
+            auto pctrl(std::make_shared<std::unique_ptr<ServerGPRExec>>(new ServerGPRExec(this, iface->server->internal_self, chan->name, val, op)));
 
             op->subcmd = subcmd;
             op->state = ServerOp::Executing;
 
             log_debug_printf(connsetup, "CLient %s Get executing\n", peerName.c_str());
 
-            try {
-                if(cmd==CMD_RPC && isput) {
-                    if(chan->onRPC)
-                        chan->onRPC(std::move(ctrl), std::move(val));
-                    else
-                        ctrl->error("RPC Not Implemented");
-
-                } else if(cmd==CMD_PUT && isput) {
-                    if(op->onPut)
-                        op->onPut(std::move(ctrl), std::move(val));
-                    else
-                        ctrl->error("PUT Not Implemented");
-
-                } else if(cmd!=CMD_RPC && !isput) {
-                    if(op->onGet)
-                        op->onGet(std::move(ctrl));
-                    else
-                        ctrl->error("GET Not Implemented");
+            auto pval(std::make_shared<Value>(std::move(val)));
+            auto peer(peerName);
+            std::weak_ptr<ServerChan> wchan(chan);
+            std::weak_ptr<ServerGPR> wop(op);
 
+            chan->callback([cmd, isput, subcmd, wchan, wop, pctrl, pval, peer]() {
+                auto& ctrl = *pctrl;
+                auto chan(wchan.lock());
+                auto op(wop.lock());
+                if(!chan || !op)
+                    return;
+
+                // Read handlers now, not when queued.  With callback workers, a handler
+                // installed from onInit() runs on this executor, after this exec may have been queued.
+                decltype(chan->onRPC) onRPC;
+                decltype(op->onPut) onPut;
+                decltype(op->onGet) onGet;
+                if(cmd==CMD_RPC) {
+                    Guard G(chan->lock);
+                    onRPC = chan->onRPC;
                 } else {
-                    log_err_printf(connsetup, "Client %s Get exec in incorrect command %d\n",
-                               peerName.c_str(), subcmd);
+                    Guard G(op->lock);
+                    onPut = op->onPut;
+                    onGet = op->onGet;
                 }
-            } catch(std::exception& e) {
-                log_err_printf(connsetup, "Client %s Unhandled exception in onGet/Put/RPC %s : %s\n",
-                           peerName.c_str(), typeid(e).name(), e.what());
-                if(ctrl)
-                    ctrl->error(e.what());
-            }
+
+                try {
+                    if(cmd==CMD_RPC && isput) {
+                        if(onRPC)
+                            onRPC(std::move(ctrl), std::move(*pval));
+                        else
+                            ctrl->error("RPC Not Implemented");
+
+                    } else if(cmd==CMD_PUT && isput) {
+                        if(onPut)
+                            onPut(std::move(ctrl), std::move(*pval));
+                        else
+                            ctrl->error("PUT Not Implemented");
+
+                    } else if(cmd!=CMD_RPC && !isput) {
+                        if(onGet)
+                            onGet(std::move(ctrl));
+                        else
+                            ctrl->error("GET Not Implemented");
+
+                    } else {
+                        log_err_printf(connsetup, "Client %s Get exec in incorrect command %d\n",
+                                   peer.c_str(), subcmd);
+                    }
+                } catch(std::exception& e) {
+                    log_err_printf(connsetup, "Client %s Unhandled exception in onGet/Put/RPC %s : %s\n",
+                               peer.c_str(), typeid(e).name(), e.what());
+                    if(ctrl)
+                        ctrl->error(e.what());
+                }
+            });
 
         } else {
             log_err_printf(connsetup, "CLient %s Get exec in incorrect state %d\n",
@@ -21,7 +21,7 @@ struct ServerIntrospect : public ServerOp
     {}
     virtual ~ServerIntrospect() {}
 
-    void doReply(const FieldDesc* type, const Status& sts)
+    void doReply(const Type& type, const Status& sts)
     {
         if(state != ServerOp::Executing)
             return;
@@ -39,7 +39,7 @@ struct ServerIntrospect : public ServerOp
             to_wire(R, uint32_t(ioid));
             to_wire(R, sts);
             if(type)
-                to_wire(R, type);
+                to_wire(R, type, conn->txRegistry);
         }
 
         conn->enqueueTxBody(CMD_GET_FIELD);
@@ -56,6 +56,7 @@ struct ServerIntrospectControl : public server::ConnectOp
                             const std::weak_ptr<server::Server::Pvt>& server,
                             const std::weak_ptr<ServerIntrospect>& op)
         :server(server)
+        ,loop(conn->loop)
         ,op(op)
     {
         _op = Info;
@@ -69,11 +70,11 @@ struct ServerIntrospectControl : public server::ConnectOp
 
     virtual void connect(const Value& prototype) override final
     {
-        auto desc = Value::Helper::desc(prototype);
-        if(!desc)
+        auto type(Value::Helper::type(prototype));
+        if(!type)
             throw std::logic_error("Can't reply to GET_FIELD with Null prototype");
         Status sts{Status::Ok};
-        doReply(desc, sts);
+        doReply(type, sts);
     }
 
     virtual void error(const std::string &msg) override final
@@ -82,13 +83,13 @@ struct ServerIntrospectControl : public server::ConnectOp
         doReply(nullptr, sts);
     }
 
-    void doReply(const FieldDesc* type, const Status& sts)
+    void doReply(const Type& type, const Status& sts)
     {
         auto serv = server.lock();
         if(!serv)
             return; // soft fail if already completed, cancelled, disconnected, ....
 
-        serv->acceptor_loop.call([this, type, &sts](){
+        loop.call([this, &type, &sts](){
             if(auto oper = op.lock())
                 oper->doReply(type, sts);
         });
@@ -99,7 +100,7 @@ struct ServerIntrospectControl : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
@@ -110,6 +111,7 @@ struct ServerIntrospectControl : public server::ConnectOp
     virtual void onPut(std::function<void(std::unique_ptr<server::ExecOp>&& fn, Value&&)>&& fn) override final {}
 
     const std::weak_ptr<server::Server::Pvt> server;
+    evbase& loop;
     const std::weak_ptr<ServerIntrospect> op;
 };
 } // namespace
@@ -144,8 +146,12 @@ void ServerConn::handle_GET_FIELD()
     opByIOID[ioid] = op;
     chan->opByIOID[ioid] = op;
 
-    if(chan->onOp)
-        chan->onOp(std::move(ctrl));
+    if(auto cb = chan->onOp) {
+        auto pctrl(std::make_shared<std::unique_ptr<ServerIntrospectControl>>(std::move(ctrl)));
+        chan->callback([cb, pctrl]() {
+            cb(std::move(*pctrl));
+        });
+    }
 }
 
 }} // namespace pvxs::impl
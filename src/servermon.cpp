@@ -5,8 +5,10 @@
  */
 
 #include <cassert>
+#include <cmath>
 
 #include <deque>
+#include <list>
 
 #include <epicsMutex.h>
 #include <epicsGuard.h>
@@ -24,25 +26,109 @@ namespace {
 
 typedef epicsGuard<epicsMutex> Guard;
 
+// smaller pieces of a shared serialization are copied rather than referenced
+constexpr size_t minReferenceSize = 0x400u;
+
+void releaseShared(const void *data, size_t datalen, void *extra)
+{
+    delete static_cast<SharedUpdate::bytes_t*>(extra);
+}
+
+// append to buf, by reference where worthwhile.
+// bytes may be concurrently appended to other buffers as it is only read.
+void appendShared(evbuffer* buf, const SharedUpdate::bytes_t& bytes)
+{
+    auto src = bytes->get();
+
+    auto n = evbuffer_peek(src, -1, nullptr, nullptr, 0);
+    std::vector<evbuffer_iovec> vecs(n);
+    n = evbuffer_peek(src, -1, nullptr, vecs.data(), n);
+
+    for(auto i : range(n)) {
+        auto& vec = vecs[i];
+        if(vec.iov_len < minReferenceSize) {
+            if(evbuffer_add(buf, vec.iov_base, vec.iov_len))
+                throw std::bad_alloc();
+
+        } else {
+            std::unique_ptr<SharedUpdate::bytes_t> ref(new SharedUpdate::bytes_t(bytes));
+            if(evbuffer_add_reference(buf, vec.iov_base, vec.iov_len, &releaseShared, ref.get()))
+                throw std::bad_alloc();
+            ref.release(); // now owned by buf
+        }
+    }
+}
+
+} // namespace
+
+SharedUpdate::bytes_t SharedUpdate::encode(const BitMask& mask)
+{
+    {
+        Guard G(lock);
+        for(auto& ent : encoded) {
+            if(ent.first==mask)
+                return ent.second;
+        }
+    }
+
+    // serialize without the lock.  Rarely, the first subscriptions with the same mask
+    // may each serialize, and use their own copy.
+    auto bytes(std::make_shared<evbuf>(evbuffer_new()));
+    {
+        EvOutBuf M(hostBE, bytes->get());
+        to_wire_valid(M, val, &mask);
+        if(!M.good())
+            throw std::bad_alloc();
+    }
+
+    BitMask key(mask.size());
+    for(auto bit : mask.onlySet())
+        key[bit] = true;
+
+    Guard G(lock);
+    encoded.emplace_back(std::move(key), bytes);
+    return bytes;
+}
+
+namespace {
+
 struct MonitorOp : public ServerOp,
                    public std::enable_shared_from_this<MonitorOp>
 {
     MonitorOp(const std::shared_ptr<ServerChan>& chan, uint32_t ioid)
         :ServerOp(chan, ioid)
     {}
-    virtual ~MonitorOp() {}
+    virtual ~MonitorOp()
+    {
+        // before other members, as holdoffExpired() uses this.
+        // From another thread, event_free() waits for a running callback to return.
+        holdoff.reset();
+    }
 
-    // only access from acceptor worker thread
+    // only access from connection worker thread
     std::function<void(bool)> onStart;
     std::function<void()> onLowMark;
     std::function<void()> onHighMark;
 
     // const after setup phase
+    std::shared_ptr<MonitorReady> ready;
     std::shared_ptr<const FieldDesc> type;
     BitMask pvMask;
     std::string msg;
 
-    // Further members can only be changed from the accepter worker thread with this lock held.
+    // record._options.deadband
+    // Updates which only change "value" by less than this, and/or "timeStamp", are dropped.
+    double deadband=0.;
+    FieldRef valueRef;
+    size_t valueIndex=0u;
+    // fields of "value" and "timeStamp"
+    BitMask deadbandIgnore;
+    // record._options.maxRate or minPeriod
+    // Updates are sent no more often.  Updates in between are squashed.
+    double minPeriod=0.;
+    evevent holdoff;
+
+    // Further members can only be changed from the connection worker thread with this lock held.
     // They may be read from the worker, or if this lock is held.
     mutable epicsMutex lock;
 
@@ -52,66 +138,253 @@ struct MonitorOp : public ServerOp,
     bool finished=false;
     size_t window=0u, limit=1u;
     size_t low=0u, high=0u;
-
-    std::deque<Value> queue;
+    // waiting for holdoff timer to expire.  Only set if minPeriod>0
+    bool holding=false;
+    // "value" of the last update which passed the deadband filter
+    bool haveLast=false;
+    double lastValue=0.;
+
+    struct Update {
+        Value val;
+        // fields which have changed more than once, the result of squashing.
+        // empty if none.
+        BitMask overrun;
+        // when val is shared with other subscriptions.  cf. SharedPV::post()
+        std::shared_ptr<SharedUpdate> shared;
+        // when val is shared, later updates squashed into this entry.
+        // Only referenced by this queue.  Marked fields take precedence over val.
+        Value delta;
+        Update(Value&& val, const std::shared_ptr<SharedUpdate>& shared)
+            :val(std::move(val))
+            ,shared(shared)
+        {}
+    };
+    std::deque<Update> queue;
 
     // caller must hold lock.
     // only used after State==Idle
     static
-    void maybeReply(server::Server::Pvt* server, const std::shared_ptr<MonitorOp>& op)
+    void maybeReply(evbase& loop, const std::shared_ptr<MonitorOp>& op)
     {
         // can we send a reply?
-        if(!op->scheduled && op->state==Executing && !op->queue.empty() && (!op->pipeline || op->window))
+        if(!op->scheduled && !op->holding && op->state==Executing && !op->queue.empty() && (!op->pipeline || op->window))
         {
-            // based on operation state, yes
-            server->acceptor_loop.dispatch([op](){
-                auto ch(op->chan.lock());
-                if(!ch)
-                    return;
-                auto conn(ch->conn.lock());
-                if(!conn)
-                    return;
+            // based on operation state, yes.
+            // Only the first ready operation wakes the worker.
+            bool wakeup;
+            {
+                Guard G(op->ready->lock);
+                wakeup = op->ready->ops.empty();
+                op->ready->ops.push_back(op);
+            }
 
-                if(conn->bev && (bufferevent_get_enabled(conn->bev.get())&EV_READ)) {
-                    op->doReply();
-                } else {
-                    // connection TX queue is too full
-                    conn->backlog.push_back(std::bind(&MonitorOp::doReply, op));
-                }
-            });
+            if(wakeup) {
+                auto ready(op->ready);
+                loop.dispatch([ready](){
+                    sendReady(ready);
+                });
+            }
 
             op->scheduled = true;
         }
     }
 
-    void doReply()
+    // during setup phase, once type is known
+    void setupDeadband(const Value& prototype)
+    {
+        if(!(deadband>0.))
+            return;
+
+        auto value(prototype["value"]);
+        auto code(value.type());
+        if(code.isarray() || (code.kind()!=Kind::Integer && code.kind()!=Kind::Real)) {
+            log_debug_printf(connsetup, "Ignoring deadband for non-numeric value %s\n", code.name());
+            deadband = 0.;
+            return;
+        }
+
+        auto top = Value::Helper::desc(prototype);
+        valueRef = FieldRef(prototype, "value");
+        valueIndex = Value::Helper::desc(value) - top;
+        if(!pvMask[valueIndex]) {
+            deadband = 0.; // "value" not requested
+            return;
+        }
+        deadbandIgnore.resize(top->size());
+
+        for(auto name : {"value", "timeStamp"}) {
+            if(auto fld = prototype[name]) {
+                auto desc = Value::Helper::desc(fld);
+                for(auto i : range(desc->size()))
+                    deadbandIgnore[desc - top + i] = true;
+            }
+        }
+    }
+
+    // caller must hold lock.
+    // Should this update be queued?
+    bool passDeadband(const Value& val)
+    {
+        if(!(deadband>0.) || !val)
+            return true;
+
+        auto& marked = Value::Helper::store_ptr(val)->top->marked;
+        bool others = false, changed = false;
+        for(auto bit = marked.findSet(); bit < marked.size(); bit = marked.findSet(bit + 1u)) {
+            if(!pvMask[bit])
+                continue;
+            else if(bit==valueIndex)
+                changed = true;
+            else if(!deadbandIgnore[bit])
+                others = true;
+        }
+
+        double cur = lastValue;
+        if(changed)
+            (void)val[valueRef].as(cur);
+
+        if(!others && haveLast && std::fabs(cur - lastValue) < deadband)
+            return false;
+
+        if(changed || !haveLast) {
+            haveLast = true;
+            lastValue = cur;
+        }
+        return true;
+    }
+
+    // on connection worker
+    void holdoffExpired()
     {
         auto ch = chan.lock();
         if(!ch)
             return;
         auto conn = ch->conn.lock();
-        if(!conn || !conn->bev)
+        if(!conn)
             return;
+        auto it = conn->opByIOID.find(ioid);
+        if(it==conn->opByIOID.end() || it->second.get()!=this)
+            return; // already destroyed
+
+        auto self(std::static_pointer_cast<MonitorOp>(it->second));
 
         Guard G(lock);
-        scheduled = false;
+        holding = false;
+        maybeReply(conn->loop, self);
+    }
+    static
+    void holdoffExpiredS(evutil_socket_t fd, short evt, void *raw)
+    {
+        try {
+            static_cast<MonitorOp*>(raw)->holdoffExpired();
+        }catch(std::exception& e) {
+            log_crit_printf(connio, "Unhandled exception in %s %s : %s\n",
+                            __func__, typeid (e).name(), e.what());
+        }
+    }
+
+    // on connection worker
+    static
+    void sendReady(const std::shared_ptr<MonitorReady>& ready)
+    {
+        decltype (ready->ops) todo;
+        ServerConn* conn;
+        {
+            Guard G(ready->lock);
+            todo.swap(ready->ops);
+            conn = ready->conn;
+        }
+        if(!conn)
+            return;
 
-        if(state==Dead)
+        // send short replies ahead of long ones.  Each op appears at most once.
+        ConnBase::HoldTx H(*conn);
+
+        for(auto& ent : todo) {
+            auto op(std::static_pointer_cast<MonitorOp>(ent));
+
+            if(conn->txReady()) {
+                op->doReply();
+            } else {
+                // connection TX queue is too full
+                conn->backlog.push_back(std::bind(&MonitorOp::doReply, op));
+            }
+        }
+    }
+
+    void doReply()
+    {
+        auto ch = chan.lock();
+        if(!ch)
             return;
+        auto conn = ch->conn.lock();
+        if(!conn || !conn->bev)
+            return;
+
+        auto self(shared_from_this());
+
+        // Only hold the lock to dequeue, so that post() from another thread
+        // does not wait while an update is serialized.
+        // Queued Values may be modified, as squashing in post() assign()s in place
+        // to the last entry when nothing else references it.
+        // Serialization is safe without the lock only because the entry is first moved
+        // out of the queue, and only this worker dequeues.
+        // Entries with a SharedUpdate are never modified in place.  Its serialization
+        // is shared with other subscriptions, and would otherwise be stale.
+        // Updates squashed into a shared entry are kept in Update::delta instead.
 
         uint8_t subcmd = 0u;
-        if(state==Creating) {
-            subcmd = 0x08;
-            state = type ? Idle : Dead;
-
-        } else if(state==Executing) {
-            if(queue.empty() || (pipeline && !window)) {
-                return; // nothing to do
-
-            } else if(!queue.front()) {
-                finished = true;
-                subcmd = 0x10;
-                state = Dead;
+        bool haveEntry = false;
+        Value ent, delta;
+        BitMask overrun;
+        std::shared_ptr<SharedUpdate> shared;
+        bool dead;
+        {
+            Guard G(lock);
+            scheduled = false;
+
+            if(state==Dead)
+                return;
+
+            if(state==Creating) {
+                subcmd = 0x08;
+                state = type ? Idle : Dead;
+
+            } else if(state==Executing) {
+                if(queue.empty() || (pipeline && !window)) {
+                    return; // nothing to do
+
+                } else if(!queue.front().val) {
+                    finished = true;
+                    subcmd = 0x10;
+                    state = Dead;
+                }
+            }
+
+            if(!(subcmd&0x08) && !queue.empty()) {
+                haveEntry = true;
+                ent = std::move(queue.front().val);
+                delta = std::move(queue.front().delta);
+                overrun = std::move(queue.front().overrun);
+                shared = std::move(queue.front().shared);
+                queue.pop_front();
+
+                // hold off further updates
+                holding = ent && minPeriod>0.;
+            }
+
+            dead = state==Dead;
+
+            if(state==Executing && pipeline) {
+                assert(window); // previously tested
+
+                bool before = window <= low;
+                window--;
+                bool after = window <= low;
+
+                if(before && after && onLowMark) {
+                    ch->callback(std::function<void()>(onLowMark), true);
+                }
             }
         }
 
@@ -121,43 +394,61 @@ struct MonitorOp : public ServerOp,
             EvOutBuf R(hostBE, conn->txBody.get());
             to_wire(R, uint32_t(ioid));
             to_wire(R, subcmd);
+            if(!R.good())
+                throw std::bad_alloc();
+
             if(subcmd&0x08) {
                 if(!msg.empty() || !type) {
                     to_wire(R, Status::error(msg));
 
                 } else {
                     to_wire(R, Status{});
-                    to_wire(R, type.get());
+                    to_wire(R, type, conn->txRegistry);
                 }
 
-            } else if(!queue.empty()) {
-                auto& ent = queue.front();
+            } else if(haveEntry) {
                 if(ent) {
-                    to_wire_valid(R, ent, &pvMask);
-                    // TODO: placeholder for overrun mask
-                    to_wire(R, uint8_t(0u));
+                    if(delta) {
+                        to_wire_valid(R, ent, delta, &pvMask);
+                    } else if(shared) {
+                        auto bytes(shared->encode(pvMask));
+                        R.refill(0); // flush before appending by reference
+                        appendShared(conn->txBody.get(), bytes);
+                    } else {
+                        to_wire_valid(R, ent, &pvMask);
+                    }
+                    to_wire(R, overrun);
 
                 } else { // finish (could be used to send an error)
                     to_wire(R, Status{});
                 }
-
-                queue.pop_front();
             }
         }
 
         conn->enqueueTxBody(pva_app_msg_t::CMD_MONITOR);
 
-        if(state == ServerOp::Dead) {
+        if(holding && !dead) { // only changed by this worker
+            timeval timo{};
+            timo.tv_sec = time_t(minPeriod);
+            timo.tv_usec = suseconds_t((minPeriod - timo.tv_sec)*1e6);
+            if(event_add(holdoff.get(), &timo)) {
+                log_err_printf(connio, "Client %s unable to start monitor holdoff timer\n", conn->peerName.c_str());
+                Guard G(lock);
+                holding = false;
+            }
+        }
+
+        if(dead) {
             ch->opByIOID.erase(ioid);
             auto it = conn->opByIOID.find(ioid);
             if(it!=conn->opByIOID.end()) {
                 auto self(it->second);
                 conn->opByIOID.erase(it);
 
-                if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
-                        self->onClose("");
-                    });
+                if(auto cb = self->onClose)
+                    ch->callback([cb](){
+                        cb("");
+                    }, true);
 
             } else {
                 assert(false); // really shouldn't happen
@@ -166,38 +457,15 @@ struct MonitorOp : public ServerOp,
             return;
         }
 
-        auto self(shared_from_this());
-
-        if(state==Executing && pipeline) {
-            assert(window); // previously tested
-
-            bool before = window <= low;
-            window--;
-            bool after = window <= low;
-
-            if(before && after && onLowMark) {
-                conn->iface->server->acceptor_loop.dispatch([self]() {
-                    if(self->onLowMark)
-                        self->onLowMark();
-                });
-            }
-        }
-
-        if(state==Executing && !queue.empty() && (!pipeline || window)) {
-            // reshedule myself
-            assert(!scheduled); // we've been holding the lock, so this should not have changed
-
-            conn->iface->server->acceptor_loop.dispatch([self]() {
-                self->doReply();
-            });
-            scheduled = true;
-        }
+        // reshedule myself.  (may already be rescheduled by post())
+        Guard G(lock);
+        maybeReply(conn->loop, self);
     }
 };
 
 struct ServerMonitorSetup;
 
-struct ServerMonitorControl : public server::MonitorControlOp
+struct ServerMonitorControl : public server::MonitorControlOp, public SharedUpdateSink
 {
     ServerMonitorControl(ServerMonitorSetup* setup,
                      const std::weak_ptr<server::Server::Pvt>& server,
@@ -208,6 +476,17 @@ struct ServerMonitorControl : public server::MonitorControlOp
     }
 
     virtual bool doPost(Value&& val, bool maybe, bool force) override final
+    {
+        return post(std::move(val), nullptr, maybe, force);
+    }
+
+    virtual bool postShared(const std::shared_ptr<SharedUpdate>& update) override final
+    {
+        Value val(update->val);
+        return post(std::move(val), update, false, false);
+    }
+
+    bool post(Value&& val, const std::shared_ptr<SharedUpdate>& shared, bool maybe, bool force)
     {
         auto mon(op.lock());
         if(!mon)
@@ -218,23 +497,61 @@ struct ServerMonitorControl : public server::MonitorControlOp
         if(val && mon->type && mon->type.get()!=Value::Helper::desc(val))
             throw std::logic_error("Type change not allowed in post()");
 
-        if((mon->queue.size() < mon->limit) || force || !val) {
-            mon->queue.push_back(std::move(val));
+        bool squash = false;
 
-        } else if(!maybe) {
-            // squash
-            assert(mon->limit>0 && !mon->queue.empty());
+        if(!force && !mon->passDeadband(val)) {
+            // insignificant change
+
+        } else if(!force && !maybe && val && mon->holding && !mon->queue.empty() && mon->queue.back().val) {
+            // rate limited.  Keep only the latest update while holding off.
+            squash = true;
 
-            mon->queue.back().assign(val);
-            // TODO track overrun
+        } else if((mon->queue.size() < mon->limit) || force || !val) {
+            mon->queue.emplace_back(std::move(val), shared);
+
+        } else if(!maybe && mon->queue.back().val) {
+            squash = true;
 
         } else {
             // nope
         }
 
-        // TODO unnecessary wakeups?
+        if(squash) {
+            assert(mon->limit>0 && !mon->queue.empty());
+            auto& ent = mon->queue.back();
+
+            // fields changed again lose their previous value
+            auto dst = Value::Helper::store_ptr(ent.val);
+            auto dlt = ent.delta ? Value::Helper::store_ptr(ent.delta) : nullptr;
+            auto src = Value::Helper::store_ptr(val);
+            auto nfld = Value::Helper::desc(val)->size();
+            auto& marked = src->top->marked;
+            for(auto bit = marked.findSet(); bit < nfld; bit = marked.findSet(bit + 1u)) {
+                if((dst[bit].isMarked() || (dlt && dlt[bit].isMarked())) && mon->pvMask[bit]) {
+                    if(ent.overrun.empty())
+                        ent.overrun.resize(nfld);
+                    ent.overrun[bit] = true;
+                }
+            }
+
+            auto& store = Value::Helper::store(ent.val);
+            if(store.use_count()==1 && !ent.delta) {
+                // only referenced by this queue.  assign() copies only the changed fields.
+                // Never the case for a SharedUpdate, which also references its val.
+                assert(!ent.shared);
+                ent.val.assign(val);
+
+            } else {
+                // shared with other subscriptions, or the poster.  Copy only
+                // the changed fields into a delta, which doReply() sends over val.
+                if(!ent.delta)
+                    ent.delta = ent.val.cloneEmpty();
+                ent.delta.assign(val);
+            }
+        }
+
         if(auto serv = server.lock())
-            MonitorOp::maybeReply(serv.get(), mon);
+            MonitorOp::maybeReply(loop, mon);
 
         return mon->queue.size() < mon->limit;
     }
@@ -264,7 +581,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, low, high](){
+        loop.call([this, low, high](){
             if(auto oper = op.lock()) {
                 Guard G(oper->lock);
                 oper->low = low;
@@ -278,7 +595,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onStart = std::move(fn);
         });
@@ -288,7 +605,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onHighMark = std::move(fn);
         });
@@ -298,13 +615,14 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onLowMark = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    evbase& loop;
     const std::weak_ptr<MonitorOp> op;
 };
 
@@ -316,6 +634,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
                      const Value& request,
                      const std::weak_ptr<MonitorOp>& op)
         :server(server)
+        ,loop(conn->loop)
         ,op(op)
     {
         _op = Info;
@@ -340,12 +659,13 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return ret;
-        serv->acceptor_loop.call([this, &type, &ret, &mask](){
+        loop.call([this, &prototype, &type, &ret, &mask](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
                 oper->type = type;
                 oper->pvMask = std::move(mask);
+                oper->setupDeadband(prototype);
                 ret.reset(new ServerMonitorControl(this, server, _name, oper));
                 oper->doReply();
             }
@@ -362,7 +682,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating) {
                     oper->msg = msg;
@@ -376,13 +696,14 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    evbase& loop;
     const std::weak_ptr<MonitorOp> op;
 };
 
@@ -392,6 +713,7 @@ ServerMonitorControl::ServerMonitorControl(ServerMonitorSetup* setup,
                                            const std::string& name,
                                            const std::weak_ptr<MonitorOp>& op)
     :server(server)
+    ,loop(setup->loop)
     ,op(op)
 {
     _op = Info;
@@ -439,6 +761,7 @@ void ServerConn::handle_MONITOR()
         }
 
         auto op(std::make_shared<MonitorOp>(chan, ioid));
+        op->ready = monReady;
         op->window = nack;
         (void)pvRequest["record._options.pipeline"].as(op->pipeline);
 
@@ -447,6 +770,20 @@ void ServerConn::handle_MONITOR()
                 op->limit = qSize;
         });
 
+        (void)pvRequest["record._options.deadband"].as(op->deadband);
+
+        pvRequest["record._options.maxRate"].as<double>([&op](double rate){
+            if(rate>0.)
+                op->minPeriod = 1.0/rate;
+        });
+        pvRequest["record._options.minPeriod"].as<double>([&op](double period){
+            op->minPeriod = std::max(op->minPeriod, period);
+        });
+
+        if(op->minPeriod>0.) {
+            op->holdoff = evevent(event_new(loop.base, -1, EV_TIMEOUT, &MonitorOp::holdoffExpiredS, op.get()));
+        }
+
         std::unique_ptr<ServerMonitorSetup> ctrl(new ServerMonitorSetup(this, iface->server->internal_self, chan->name, pvRequest, op));
 
         op->state = ServerOp::Creating;
@@ -458,8 +795,11 @@ void ServerConn::handle_MONITOR()
                    peerName.c_str(), unsigned(ioid),
                    std::string(SB()<<pvRequest).c_str());
 
-        if(chan->onSubscribe) {
-            chan->onSubscribe(std::move(ctrl));
+        if(auto cb = chan->onSubscribe) {
+            auto pctrl(std::make_shared<std::unique_ptr<ServerMonitorSetup>>(std::move(ctrl)));
+            chan->callback([cb, pctrl]() {
+                cb(std::move(*pctrl));
+            });
         } else {
             ctrl->error("Monitor operation not implemented by this PV");
         }
@@ -515,10 +855,7 @@ void ServerConn::handle_MONITOR()
             bool after = op->window > op->high;
 
             if(!before && after && op->onHighMark) {
-                iface->server->acceptor_loop.dispatch([op](){
-                    if(op->onHighMark)
-                        op->onHighMark();
-                });
+                chan->callback(std::function<void()>(op->onHighMark), true);
             }
         }
 
@@ -533,12 +870,14 @@ void ServerConn::handle_MONITOR()
                 op->state = start ? ServerOp::Executing : ServerOp::Idle;
             }
 
-            if(op->onStart)
-                op->onStart(start);
+            if(auto cb = op->onStart)
+                chan->callback([cb, start]() {
+                    cb(start);
+                });
 
             {
                 Guard G(op->lock);
-                MonitorOp::maybeReply(iface->server, op);
+                MonitorOp::maybeReply(loop, op);
             }
         }
 
@@ -551,11 +890,10 @@ void ServerConn::handle_MONITOR()
                 auto self(it->second);
                 opByIOID.erase(it);
 
-                if(self->onClose) {
-                    iface->server->acceptor_loop.dispatch([self](){
-                        if(self->onClose)
-                            self->onClose("");
-                    });
+                if(auto cb = self->onClose) {
+                    chan->callback([cb](){
+                        cb("");
+                    }, true);
                 }
 
             } else {
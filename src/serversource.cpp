@@ -56,9 +56,9 @@ void ServerSource::onCreate(std::unique_ptr<server::ChannelControl> &&op)
 
             std::set<std::string> names;
             {
-                auto L(serv->sourcesLock.lockReader());
+                auto srcs(serv->sources.load());
 
-                for(auto& pair : serv->sources) {
+                for(auto& pair : *srcs) {
                     auto list = pair.second->onList();
                     if(list.names) {
                         for(auto& name : *list.names) {
@@ -94,6 +94,56 @@ void ServerSource::onCreate(std::unique_ptr<server::ChannelControl> &&op)
     });
 }
 
+NameIndex::NameIndex(size_t nexpect)
+    :nbits(64u)
+{
+    // at least 16 bits per name gives a false positive rate below 1% with 3 probes
+    while(nbits < 16u*nexpect)
+        nbits <<= 1u;
+    bloom.resize(nbits/64u, 0u);
+    names.reserve(nexpect);
+}
+
+namespace {
+// FNV-1a
+uint64_t nameHash(const char *name)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for(; *name; name++) {
+        hash ^= uint8_t(*name);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+constexpr unsigned nProbes = 3u;
+} // namespace
+
+void NameIndex::insert(const std::string& name)
+{
+    auto hash = nameHash(name.c_str());
+    auto step = (hash>>33u) | 1u;
+    for(auto i : range(nProbes)) {
+        (void)i;
+        auto bit = hash & (nbits-1u);
+        bloom[bit/64u] |= uint64_t(1u)<<(bit%64u);
+        hash += step;
+    }
+    names.insert(name);
+}
+
+bool NameIndex::contains(const char *name) const
+{
+    auto hash = nameHash(name);
+    auto step = (hash>>33u) | 1u;
+    for(auto i : range(nProbes)) {
+        (void)i;
+        auto bit = hash & (nbits-1u);
+        if(!(bloom[bit/64u] & (uint64_t(1u)<<(bit%64u))))
+            return false;
+        hash += step;
+    }
+    return names.find(name)!=names.end();
+}
 
 } // namespace impl
 } // namespace pvxs
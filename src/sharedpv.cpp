@@ -6,6 +6,8 @@
 
 #include <set>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 #include <epicsTime.h>
 #include <epicsMutex.h>
@@ -17,6 +19,8 @@
 #include <pvxs/server.h>
 
 #include "utilpvt.h"
+#include "dataimpl.h"
+#include "serverconn.h"
 
 typedef epicsGuard<epicsMutex> Guard;
 typedef epicsGuardRelease<epicsMutex> UnGuard;
@@ -45,6 +49,22 @@ struct SharedPV::Impl : public std::enable_shared_from_this<Impl>
     std::set<std::shared_ptr<MonitorControlOp>> subscribers;
 
     Value current;
+    // Copy of current which is never modified, and so may be shared by any number
+    // of GET replies and initial subscription updates.  Empty until needed.
+    // Reset whenever current changes.
+    Value snapshot;
+
+    // see detectChanges()
+    bool onlyChanges = false;
+    bool compareArrays = false;
+
+    // caller must hold lock
+    const Value& currentSnapshot()
+    {
+        if(!snapshot && current)
+            snapshot = current.clone();
+        return snapshot;
+    }
 };
 
 SharedPV SharedPV::buildMailbox()
@@ -137,8 +157,7 @@ void SharedPV::attach(std::unique_ptr<ChannelControl>&& ctrlop)
             Value got;
             {
                 Guard G(self->lock);
-                if(self->current)
-                    got = self->current.clone();
+                got = self->currentSnapshot();
             }
             if(got) {
                 op->reply(got);
@@ -175,6 +194,7 @@ void SharedPV::attach(std::unique_ptr<ChannelControl>&& ctrlop)
 
             log_debug_printf(logshared, "%s on %s OP onClose\n", conn->peerName().c_str(), conn->name().c_str());
 
+            Guard G(self->lock);
             self->pending.erase(conn);
         });
 
@@ -212,17 +232,26 @@ void SharedPV::attach(std::unique_ptr<ChannelControl>&& ctrlop)
             self->mpending.insert(std::move(conn));
 
         } else {
-            auto ctrl = conn->connect(self->current);
-            std::shared_ptr<MonitorControlOp> sub(std::move(ctrl));
+            // connect() waits for the server worker, which may be waiting for our lock.
+            auto prototype(self->current);
+            std::shared_ptr<MonitorControlOp> sub;
+            {
+                UnGuard U(G);
+                sub = conn->connect(prototype);
 
-            conn->onClose([self, sub](const std::string& msg) {
-                log_debug_printf(logshared, "%s on %s Monitor onClose\n", sub->peerName().c_str(), sub->name().c_str());
-                Guard G(self->lock);
-                self->subscribers.erase(sub);
-            });
+                conn->onClose([self, sub](const std::string& msg) {
+                    log_debug_printf(logshared, "%s on %s Monitor onClose\n", sub->peerName().c_str(), sub->name().c_str());
+                    Guard G(self->lock);
+                    self->subscribers.erase(sub);
+                });
+            }
 
-            sub->post(self->current.clone());
-            self->subscribers.emplace(std::move(sub));
+            // close() may have intervened, and also closes this channel
+            if(self->current && Value::Helper::desc(self->current)==Value::Helper::desc(prototype)) {
+                Value update(self->currentSnapshot());
+                sub->post(std::move(update));
+                self->subscribers.emplace(std::move(sub));
+            }
         }
     });
 
@@ -311,6 +340,7 @@ void SharedPV::open(const Value& initial)
         mpending = std::move(impl->mpending);
 
         impl->current = initial.clone();
+        impl->snapshot = Value();
     }
 
     // TODO the following is really inefficient if we aren't on a worker.
@@ -337,7 +367,8 @@ void SharedPV::open(const Value& initial)
 
         //c++17 adds std::set::merge()
         for(auto& sub : subscribers) {
-            sub->post(impl->current.clone());
+            Value update(impl->currentSnapshot());
+            sub->post(std::move(update));
             impl->subscribers.insert(sub);
         }
     }
@@ -365,6 +396,7 @@ void SharedPV::close()
             return; // ignore double close()
 
         impl->current = Value();
+        impl->snapshot = Value();
 
         impl->subscribers.clear();
         channels = std::move(impl->channels);
@@ -376,6 +408,15 @@ void SharedPV::close()
     }
 }
 
+void SharedPV::detectChanges(bool enable, bool compareArrays)
+{
+    if(!impl)
+        throw std::logic_error("Empty SharedPV");
+    Guard G(impl->lock);
+    impl->onlyChanges = enable;
+    impl->compareArrays = compareArrays;
+}
+
 void SharedPV::post(Value&& val)
 {
     if(!impl)
@@ -383,10 +424,32 @@ void SharedPV::post(Value&& val)
 
     Guard G(impl->lock);
 
+    if(impl->onlyChanges && impl->current.compareType(val)
+            && !val.unmarkUnchanged(impl->current, impl->compareArrays))
+        return; // nothing changed
+
     impl->current.assign(val);
+    impl->snapshot = Value();
+
+    if(impl->subscribers.empty())
+        return;
+
+    // one copy of the update is shared by all subscribers
+    auto update(val.clone());
+
+    // with more than one subscriber, they may also share its serialization
+    std::shared_ptr<impl::SharedUpdate> shared;
+    if(impl->subscribers.size()>1u)
+        shared = std::make_shared<impl::SharedUpdate>(update);
 
     for(auto& sub : impl->subscribers) {
-        sub->post(val.clone());
+        auto sink = shared ? dynamic_cast<impl::SharedUpdateSink*>(sub.get()) : nullptr;
+        if(sink) {
+            sink->postShared(shared);
+        } else {
+            Value copy(update);
+            sub->post(std::move(copy));
+        }
     }
 }
 
@@ -404,19 +467,49 @@ void SharedPV::fetch(Value& val)
     }
 }
 
-struct StaticSource::Impl : public Source
+struct StaticSource::Impl : public Source, public WatchedList
 {
-    RWLock lock;
+    typedef std::map<std::string, SharedPV> pvs_t;
+
+    // immutable once published
+    struct Snapshot {
+        pvs_t pvs;
+        // built on first use
+        mutable std::once_flag listOnce;
+        mutable decltype (List::names) list;
+    };
+
+    // serializes changes to pvs
+    epicsMutex lock;
+    pvs_t pvs;
+    // copy of pvs.  Readers do not lock.
+    SnapshotPtr<Snapshot> current;
+
+    Impl()
+    {
+        current.store(std::make_shared<Snapshot>());
+    }
 
-    std::map<std::string, SharedPV> pvs;
-    decltype (List::names) list;
+    std::shared_ptr<const Snapshot> snapshot() const
+    {
+        return current.load();
+    }
+
+    // caller must hold lock.  Then call listChanged() without lock.
+    // A batch of changes is published together.
+    void changed()
+    {
+        auto next(std::make_shared<Snapshot>());
+        next->pvs = pvs;
+        current.store(std::move(next));
+    }
 
     virtual void onSearch(Search &op) override
     {
-        auto G(lock.lockReader());
+        auto snap(snapshot());
         for(auto& name : op) {
-            auto it(pvs.find(name.name()));
-            if(it!=pvs.end())
+            auto it(snap->pvs.find(name.name()));
+            if(it!=snap->pvs.end())
                 name.claim();
         }
     }
@@ -425,9 +518,9 @@ struct StaticSource::Impl : public Source
     {
         SharedPV pv;
         {
-            auto G(lock.lockReader());
-            auto it(pvs.find(op->name()));
-            if(it==pvs.end())
+            auto snap(snapshot());
+            auto it(snap->pvs.find(op->name()));
+            if(it==snap->pvs.end())
                 return; // not mine
             pv = it->second;
         }
@@ -437,18 +530,18 @@ struct StaticSource::Impl : public Source
 
     virtual List onList() override
     {
-        List ret;
-        auto G(lock.lockReader());
+        auto snap(snapshot());
 
-        if(!list || list.use_count()!=1u) {
+        std::call_once(snap->listOnce, [&snap]() {
             auto temp = std::make_shared<std::set<std::string>>();
-            for(auto& pair : pvs) {
-                temp->emplace(pair.first);
+            for(auto& pair : snap->pvs) {
+                temp->emplace_hint(temp->end(), pair.first);
             }
-            list = std::move(temp);
-        }
+            snap->list = std::move(temp);
+        });
 
-        ret.names = list;
+        List ret;
+        ret.names = snap->list;
         ret.dynamic = false;
 
         return ret;
@@ -476,13 +569,39 @@ StaticSource& StaticSource::add(const std::string& name, const SharedPV &pv)
     if(!impl)
         throw std::logic_error("Empty StaticSource");
 
-    auto G(impl->lock.lockWriter());
+    {
+        Guard G(impl->lock);
 
-    if(impl->pvs.find(name)!=impl->pvs.end())
-        throw std::logic_error("add() will not create duplicate PV");
+        if(impl->pvs.find(name)!=impl->pvs.end())
+            throw std::logic_error("add() will not create duplicate PV");
 
-    impl->pvs[name] = pv;
-    impl->list.reset();
+        impl->pvs[name] = pv;
+        impl->changed();
+    }
+    impl->listChanged();
+
+    return *this;
+}
+
+StaticSource& StaticSource::add(const std::map<std::string, SharedPV>& pvs)
+{
+    if(!impl)
+        throw std::logic_error("Empty StaticSource");
+
+    {
+        Guard G(impl->lock);
+
+        for(auto& pair : pvs) {
+            if(impl->pvs.find(pair.first)!=impl->pvs.end())
+                throw std::logic_error("add() will not create duplicate PV");
+        }
+
+        for(auto& pair : pvs) {
+            impl->pvs.emplace(pair.first, pair.second);
+        }
+        impl->changed();
+    }
+    impl->listChanged();
 
     return *this;
 }
@@ -494,20 +613,50 @@ StaticSource& StaticSource::remove(const std::string& name)
 
     SharedPV pv;
     {
-        auto G(impl->lock.lockWriter());
+        Guard G(impl->lock);
 
         auto it(impl->pvs.find(name));
         if(it==impl->pvs.end())
             return *this;
         pv = it->second;
         impl->pvs.erase(it);
-        impl->list.reset();
+        impl->changed();
     }
+    impl->listChanged();
 
     pv.close();
 
     return *this;
 }
 
+StaticSource& StaticSource::remove(const std::vector<std::string>& names)
+{
+    if(!impl)
+        throw std::logic_error("Empty StaticSource");
+
+    std::vector<SharedPV> removed;
+    removed.reserve(names.size());
+    {
+        Guard G(impl->lock);
+
+        for(auto& name : names) {
+            auto it(impl->pvs.find(name));
+            if(it==impl->pvs.end())
+                continue;
+            removed.push_back(it->second);
+            impl->pvs.erase(it);
+        }
+        if(!removed.empty())
+            impl->changed();
+    }
+    if(!removed.empty())
+        impl->listChanged();
+
+    for(auto& pv : removed)
+        pv.close();
+
+    return *this;
+}
+
 } // namespace server
 } // namespace pvxs
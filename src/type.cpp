@@ -5,9 +5,11 @@
  */
 
 #include <cstring>
-#include <epicsAssert.h>
+#include <unordered_map>
 
+#include <epicsAssert.h>
 #include <epicsStdlib.h>
+#include <epicsThread.h>
 
 #include "dataimpl.h"
 #include "utilpvt.h"
@@ -88,8 +90,9 @@ const char* TypeCode::name() const
 static
 void node_validate(const Member* parent, const std::string& id, TypeCode code)
 {
-    if(!id.empty() && code!=TypeCode::Struct && code!=TypeCode::Union)
-        throw std::logic_error("Only Struct or Union may have an ID");
+    // the ID of a StructA or UnionA is given to its elements
+    if(!id.empty() && code.scalarOf()!=TypeCode::Struct && code.scalarOf()!=TypeCode::Union)
+        throw std::logic_error("Only (array of) Struct or Union may have an ID");
     if(parent) {
         auto c = parent->code.scalarOf();
         if(c!=TypeCode::Struct && c!=TypeCode::Union)
@@ -165,7 +168,10 @@ void build_tree(std::vector<FieldDesc>& desc, const Member& node)
         auto& fld = desc.back();
         fld.code = code;
         fld.id = node.id;
-        fld.hash = code.code ^ std::hash<std::string>{}(fld.id);
+        // must match from_wire(), which only hashes the ID of Struct/Union
+        fld.hash = code.code;
+        if(code.code==TypeCode::Struct || code.code==TypeCode::Union)
+            fld.hash ^= std::hash<std::string>{}(fld.id);
     }
 
     auto& cdescs = code.code==TypeCode::Struct ? desc : desc.back().members;
@@ -196,16 +202,109 @@ void build_tree(std::vector<FieldDesc>& desc, const Member& node)
     }
 
     assert(desc.size()==index+desc[index].size());
+
+    build_plan(&desc[index]);
+}
+
+namespace impl {
+namespace {
+
+typedef epicsGuard<epicsMutex> Guard;
+
+struct type_gbl_t {
+    epicsMutex lock;
+    // FieldDesc::hash of top node -> type tree
+    std::unordered_multimap<size_t, std::weak_ptr<const std::vector<FieldDesc>>> types;
+} *type_gbl;
+
+epicsThreadOnceId type_once = EPICS_THREAD_ONCE_INIT;
+
+void type_init(void *unused)
+{
+    (void)unused;
+    type_gbl = new type_gbl_t;
+}
+
+bool same_tree(const std::vector<FieldDesc>& lhs, const std::vector<FieldDesc>& rhs);
+
+bool same_node(const FieldDesc& lhs, const FieldDesc& rhs)
+{
+    // mlookup and plan are computed from miter
+    return lhs.code==rhs.code
+            && lhs.hash==rhs.hash
+            && lhs.parent_index==rhs.parent_index
+            && lhs.id==rhs.id
+            && lhs.miter==rhs.miter
+            && same_tree(lhs.members, rhs.members);
+}
+
+bool same_tree(const std::vector<FieldDesc>& lhs, const std::vector<FieldDesc>& rhs)
+{
+    if(lhs.size()!=rhs.size())
+        return false;
+    for(auto i : range(lhs.size())) {
+        if(!same_node(lhs[i], rhs[i]))
+            return false;
+    }
+    return true;
 }
 
+// remove our (now expired) entry when the last reference to a tree is released
+void type_release(std::vector<FieldDesc>* descs)
+{
+    {
+        Guard G(type_gbl->lock);
+
+        auto range(type_gbl->types.equal_range(descs->front().hash));
+        for(auto it = range.first; it!=range.second;) {
+            if(it->second.expired())
+                it = type_gbl->types.erase(it);
+            else
+                ++it;
+        }
+    }
+    delete descs;
+}
+
+} // namespace
+
+Type intern_type(std::vector<FieldDesc>&& descs)
+{
+    if(descs.empty())
+        return Type();
+
+    epicsThreadOnce(&type_once, &type_init, nullptr);
+    assert(type_gbl);
+
+    const auto hash = descs.front().hash;
+
+    Guard G(type_gbl->lock);
+
+    auto range(type_gbl->types.equal_range(hash));
+    for(auto it = range.first; it!=range.second; ++it) {
+        if(auto existing = it->second.lock()) {
+            if(same_tree(*existing, descs))
+                return Type(existing, existing->data()); // alias
+        }
+    }
+
+    std::shared_ptr<std::vector<FieldDesc>> tree(new std::vector<FieldDesc>(std::move(descs)),
+                                                 &type_release);
+    type_gbl->types.emplace(hash, tree);
+
+    return Type(tree, tree->data()); // alias
+}
+
+} // namespace impl
+
 TypeDef::TypeDef(TypeCode code, const std::string& id, std::initializer_list<Member> children)
 {
     auto temp(std::make_shared<Member>(code, "", id, children));
 
-    auto tempdesc = std::make_shared<std::vector<FieldDesc>>();
-    build_tree(*tempdesc, *temp);
+    std::vector<FieldDesc> tempdesc;
+    build_tree(tempdesc, *temp);
 
-    std::shared_ptr<const FieldDesc> type(tempdesc, tempdesc->data()); // alias
+    auto type(impl::intern_type(std::move(tempdesc)));
 
     top = std::move(temp);
     desc = std::move(type);
@@ -232,10 +331,10 @@ TypeDef::TypeDef(const Value& val)
 
         copy_tree(val.desc, *root);
 
-        auto temp = std::make_shared<std::vector<FieldDesc>>();
-        build_tree(*temp, *root);
+        std::vector<FieldDesc> temp;
+        build_tree(temp, *root);
 
-        std::shared_ptr<const FieldDesc> type(temp, temp->data()); // alias
+        auto type(impl::intern_type(std::move(temp)));
 
         top = std::move(root);
         desc = std::move(type);
@@ -287,10 +386,10 @@ TypeDef& TypeDef::operator+=(std::initializer_list<Member> children)
         append_tree(*edit, child);
     }
 
-    auto temp = std::make_shared<std::vector<FieldDesc>>();
-    build_tree(*temp, *edit);
+    std::vector<FieldDesc> temp;
+    build_tree(temp, *edit);
 
-    std::shared_ptr<const FieldDesc> type(temp, temp->data()); // alias
+    auto type(impl::intern_type(std::move(temp)));
 
     top = std::move(edit);
     desc = std::move(type);
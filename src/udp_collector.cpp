@@ -40,7 +40,20 @@ struct UDPCollector : public UDPManager::Search,
     evsocket sock;
     evevent rx;
 
-    std::vector<uint8_t> buf;
+    // receive buffers for a batch of datagrams
+    static constexpr size_t nBatch = 8u;
+    static constexpr size_t bufSize = 0x10001;
+    std::vector<uint8_t> rxbuf;
+    std::vector<evsocket::mmsg> rxmsgs;
+
+    // search replies queued while processing a batch
+    struct Reply {
+        SockAddr dest;
+        std::vector<uint8_t> msg;
+    };
+    mutable std::vector<Reply> replies;
+    mutable size_t nreplies = 0u;
+    std::vector<evsocket::mmsg> txmsgs;
 
     UDPManager::Beacon beaconMsg;
 
@@ -49,13 +62,17 @@ struct UDPCollector : public UDPManager::Search,
     UDPCollector(const std::shared_ptr<UDPManager::Pvt>& manager, const SockAddr& bind_addr);
     ~UDPCollector();
 
-    bool handle_one()
+    // receive and process one batch.  returns false when no more datagrams are available
+    bool handle_batch()
     {
-        osiSocklen_t alen = src.size();
+        for(auto i : range(nBatch)) {
+            // For Search messages, we use PV name strings in-place by adding nils.
+            // Ensure one extra byte at the end of each buffer for a nil after the last PV name
+            rxmsgs[i].buf = &rxbuf[i*bufSize];
+            rxmsgs[i].len = bufSize-1u;
+        }
 
-        // For Search messages, we use PV name strings in-place by adding nils.
-        // Ensure one extra byte at the end of the buffer for a nil after the last PV name
-        const int nrx = recvfrom(sock.sock, (char*)&buf[0], buf.size()-1, 0, &src->sa, &alen);
+        const int nrx = sock.recvmmsg(rxmsgs.data(), rxmsgs.size());
 
         if(nrx<0) {
             int err = evutil_socket_geterror(sock.sock);
@@ -66,8 +83,24 @@ struct UDPCollector : public UDPManager::Search,
                            evutil_socket_error_to_string(err));
             }
             return false; // wait for more I/O
+        }
+
+        for(auto i : range(nrx)) {
+            src = rxmsgs[i].addr;
+            (void)handle_one(static_cast<uint8_t*>(rxmsgs[i].buf), int(rxmsgs[i].len));
+        }
+
+        flush_replies();
 
-        } else if(nrx<8) {
+        // a partial batch means the socket has been drained
+        return size_t(nrx)==rxmsgs.size();
+    }
+
+    void flush_replies();
+
+    bool handle_one(uint8_t* buf, const int nrx)
+    {
+        if(nrx<8) {
             // maybe a zero (body) length packet?
             // maybe an OS error?
 
@@ -92,7 +125,7 @@ struct UDPCollector : public UDPManager::Search,
 
         bool be = buf[2]&pva_flags::MSB;
 
-        FixedBuf M(be, buf.data(), nrx);
+        FixedBuf M(be, buf, nrx);
 
         uint8_t cmd = M[3];
 
@@ -214,8 +247,8 @@ struct UDPCollector : public UDPManager::Search,
         if(!(ev&EV_READ))
             return;
 
-        // handle up to 4 packets before going back to the reactor
-        for(unsigned i=0; i<4 && handle_one(); i++) {}
+        // handle up to 4 batches before going back to the reactor
+        for(unsigned i=0; i<4 && handle_batch(); i++) {}
     }
     static void handle_static(evutil_socket_t fd, short ev, void *raw)
     {
@@ -255,7 +288,8 @@ UDPCollector::UDPCollector(const std::shared_ptr<UDPManager::Pvt>& manager, cons
     ,bind_addr(bind_addr)
     ,sock(bind_addr.family(), SOCK_DGRAM, 0)
     ,rx(event_new(manager->loop.base, sock.sock, EV_READ|EV_PERSIST, &handle_static, this))
-    ,buf(0x10001)
+    ,rxbuf(nBatch*bufSize)
+    ,rxmsgs(nBatch)
     ,beaconMsg(src)
 {
     manager->loop.assertInLoop();
@@ -429,18 +463,41 @@ bool UDPCollector::reply(const void *msg, size_t msglen) const
 {
     manager->loop.assertInLoop();
 
-    int ntx = sendto(sock.sock, (char*)msg, msglen, 0, &src->sa, src.size());
-    if(ntx<0) {
-        int err = evutil_socket_geterror(sock.sock);
-        if(err==SOCK_EWOULDBLOCK || err==EAGAIN || err==SOCK_EINTR) {
-            // nothing to do here
+    // sent along with any other replies at the end of the current batch
+    if(nreplies==replies.size())
+        replies.emplace_back();
+    auto& ent = replies[nreplies++];
+    ent.dest = src;
+    ent.msg.assign(static_cast<const uint8_t*>(msg), static_cast<const uint8_t*>(msg)+msglen);
+
+    return true;
+}
+
+void UDPCollector::flush_replies()
+{
+    txmsgs.resize(nreplies);
+    for(auto i : range(nreplies)) {
+        txmsgs[i].addr = replies[i].dest;
+        txmsgs[i].buf = replies[i].msg.data();
+        txmsgs[i].len = replies[i].msg.size();
+    }
+    nreplies = 0u;
+
+    for(size_t i=0; i<txmsgs.size(); ) {
+        int ntx = sock.sendmmsg(&txmsgs[i], txmsgs.size()-i);
+        if(ntx<0) {
+            int err = evutil_socket_geterror(sock.sock);
+            if(err==SOCK_EWOULDBLOCK || err==EAGAIN || err==SOCK_EINTR) {
+                // nothing to do here
+            } else {
+                log_warn_printf(logio, "UDP TX Error on %s : %s\n", name.c_str(),
+                           evutil_socket_error_to_string(err));
+            }
+            i++; // drop this reply
         } else {
-            log_warn_printf(logio, "UDP TX Error on %s : %s\n", name.c_str(),
-                       evutil_socket_error_to_string(err));
+            i += ntx;
         }
-        return false; // wait for more I/O
     }
-    return size_t(ntx)==msglen;
 }
 
 UDPManager::Search::~Search() {}
@@ -57,6 +57,7 @@ struct PVXS_API UDPManager
         decltype (names)::const_iterator begin() const { return names.begin(); }
         decltype (names)::const_iterator end() const   { return names.end(); }
 
+        //! Queue reply to src.  Replies are sent together once the current batch of datagrams has been handled.
         virtual bool reply(const void *msg, size_t msglen) const =0;
         virtual ~Search();
     };
@@ -393,6 +393,42 @@ unsigned short as_str<unsigned short>::op(const char *s)
     }
     return ret;
 }
+
+template<>
+unsigned as_str<unsigned>::op(const char *s)
+{
+    epicsUInt32 ret;
+    if(int err = epicsParseUInt32(s, &ret, 0, nullptr)) {
+        (void)err;
+        throw std::runtime_error(SB()<<"Unable to parse as uint32 : "<<s);
+    }
+    return ret;
+}
+}
+
+WatchedList::~WatchedList() {}
+
+void WatchedList::watch(const void* key, std::function<void()>&& fn)
+{
+    epicsGuard<epicsMutex> G(watchLock);
+    auto& ent = watchers[key];
+    if(!ent.refs++)
+        ent.fn = std::move(fn);
+}
+
+void WatchedList::unwatch(const void* key)
+{
+    epicsGuard<epicsMutex> G(watchLock);
+    auto it(watchers.find(key));
+    if(it!=watchers.end() && !--it->second.refs)
+        watchers.erase(it);
+}
+
+void WatchedList::listChanged()
+{
+    epicsGuard<epicsMutex> G(watchLock);
+    for(auto& pair : watchers)
+        pair.second.fn();
 }
 
 void indent(std::ostream& strm, unsigned level) {
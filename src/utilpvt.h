@@ -14,11 +14,16 @@
 #endif
 
 #include <memory>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <string>
 #include <sstream>
 #include <type_traits>
 
 #include <compilerDependencies.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
 
 #include <pvxs/version.h>
 #include <pvxs/util.h>
@@ -145,6 +150,63 @@ public:
 
 void logger_shutdown();
 
+/* Publishes immutable snapshots of a T.
+ * Readers take a reference to the current snapshot without locking.
+ * Writers build a new T and replace the current snapshot.
+ * Concurrent writers must be serialized by the caller.
+ */
+template<typename T>
+class SnapshotPtr {
+    std::shared_ptr<const T> current;
+#if GCC_VERSION && GCC_VERSION<VERSION_INT(5,0,0,0)
+    // no std::atomic_load() for shared_ptr
+    mutable epicsMutex lock;
+public:
+    inline std::shared_ptr<const T> load() const {
+        epicsGuard<epicsMutex> G(lock);
+        return current;
+    }
+    inline void store(std::shared_ptr<const T>&& next) {
+        epicsGuard<epicsMutex> G(lock);
+        current.swap(next);
+    }
+#else
+public:
+    inline std::shared_ptr<const T> load() const {
+        return std::atomic_load(&current);
+    }
+    inline void store(std::shared_ptr<const T>&& next) {
+        std::atomic_store(&current, std::move(next));
+    }
+#endif
+};
+
+/* Mix-in for a server::Source whose Source::List is static, except for explicit changes.
+ * Call listChanged() after each change, once onList() returns the new list,
+ * so that each Server using this Source can update its search index.
+ * Only Sources with this mix-in are included in a search index.
+ */
+struct WatchedList {
+    virtual ~WatchedList();
+
+    // Add a watcher, or a reference to an existing watcher, with this key.
+    void watch(const void* key, std::function<void()>&& fn);
+    // Remove one reference.  Once unwatch() returns, the watcher is not running.
+    void unwatch(const void* key);
+
+    // Call each watcher.  Caller must not hold locks which a watcher may take.
+    void listChanged();
+
+private:
+    struct Watcher {
+        size_t refs;
+        std::function<void()> fn;
+    };
+    // serializes watchers, including calls to them
+    epicsMutex watchLock;
+    std::map<const void*, Watcher> watchers;
+};
+
 // std::max() isn't constexpr until c++14 :(
 constexpr size_t cmax(size_t A, size_t B) {
     return A>B ? A : B;
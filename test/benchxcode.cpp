@@ -0,0 +1,175 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Time (de)serialization of some common structures.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+#include <epicsTime.h>
+#include <epicsGetopt.h>
+
+#include <pvxs/data.h>
+#include <pvxs/nt.h>
+#include "dataimpl.h"
+#include "pvaproto.h"
+
+namespace {
+using namespace pvxs;
+using namespace pvxs::impl;
+
+Value makeScalar()
+{
+    auto val(nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+
+    val["value"] = 42.5;
+    val["alarm.severity"] = 1;
+    val["alarm.status"] = 2;
+    val["alarm.message"] = "HIGH";
+    val["timeStamp.secondsPastEpoch"] = 1234567890;
+    val["timeStamp.nanoseconds"] = 123456;
+    val["display.limitLow"] = -100.0;
+    val["display.limitHigh"] = 100.0;
+    val["display.description"] = "A value";
+    val["display.units"] = "V";
+    val["control.limitLow"] = -10.0;
+    val["control.limitHigh"] = 10.0;
+    val["valueAlarm.active"] = true;
+    val["valueAlarm.lowAlarmLimit"] = -90.0;
+    val["valueAlarm.highAlarmLimit"] = 90.0;
+
+    return val;
+}
+
+Value makeNDArray(size_t nelem)
+{
+    auto val(nt::NTNDArray{}.create());
+
+    shared_array<uint8_t> pixels(nelem);
+    for(auto i : range(nelem))
+        pixels[i] = uint8_t(i);
+    val["value->ubyteValue"] = pixels.freeze().castTo<const void>();
+
+    val["compressedSize"] = int64_t(nelem);
+    val["uncompressedSize"] = int64_t(nelem);
+    val["uniqueId"] = 42;
+    val["codec.name"] = "";
+    val["timeStamp.secondsPastEpoch"] = 1234567890;
+    val["timeStamp.nanoseconds"] = 123456;
+    val["dataTimeStamp.secondsPastEpoch"] = 1234567890;
+    val["dataTimeStamp.nanoseconds"] = 123456;
+
+    auto fdim(val["dimension"]);
+    shared_array<Value> dims(2);
+    for(auto& dim : dims) {
+        dim = fdim.allocMember();
+        dim["size"] = int32_t(nelem/2u);
+        dim["fullSize"] = int32_t(nelem/2u);
+        dim["binning"] = 1;
+    }
+    fdim = dims.freeze().castTo<const void>();
+
+    auto fattr(val["attribute"]);
+    shared_array<Value> attrs(4);
+    for(auto i : range(attrs.size())) {
+        auto& attr = attrs[i];
+        attr = fattr.allocMember();
+        attr["name"] = std::string(SB()<<"attr"<<i);
+        attr["descriptor"] = "An attribute";
+        attr["sourceType"] = 0;
+        attr["timeStamp.secondsPastEpoch"] = 1234567890;
+    }
+    fattr = attrs.freeze().castTo<const void>();
+
+    return val;
+}
+
+void bench(const char* name, const Value& val, size_t count)
+{
+    std::vector<uint8_t> buf(1024u);
+    size_t nbytes = 0u;
+
+    epicsTimeStamp start, end;
+
+    epicsTimeGetCurrent(&start);
+    for(auto i : range(count)) {
+        (void)i;
+        VectorOutBuf M(true, buf);
+        to_wire_full(M, val);
+        nbytes = M.consumed();
+        if(!M.good()) {
+            std::cerr<<"Encode error\n";
+            exit(1);
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    auto tenc = epicsTimeDiffInSeconds(&end, &start);
+
+    TypeStore registry;
+    auto out(val.cloneEmpty());
+
+    epicsTimeGetCurrent(&start);
+    for(auto i : range(count)) {
+        (void)i;
+        FixedBuf M(true, buf.data(), nbytes);
+        from_wire_full(M, registry, out);
+        if(!M.good()) {
+            std::cerr<<"Decode error\n";
+            exit(1);
+        }
+    }
+    epicsTimeGetCurrent(&end);
+    auto tdec = epicsTimeDiffInSeconds(&end, &start);
+
+    printf("%-10s %6zu bytes  encode %8.1f ns  decode %8.1f ns\n",
+           name, nbytes, tenc*1e9/count, tdec*1e9/count);
+}
+
+void usage(const char *argv0)
+{
+    std::cerr<<"Usage: "<<argv0<<" [-n <count>] [-a <nelem>]\n"
+               "\n"
+               "  -n <count>  Number of iterations.  (default 100000)\n"
+               "  -a <nelem>  Number of NTNDArray elements.  (default 16)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t count = 100000u, nelem = 16u;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "hn:a:")) != -1) {
+        switch (opt) {
+        case 'h':               /* Print usage */
+            usage(argv[0]);
+            return 0;
+        case 'n':
+            count = strtoul(optarg, nullptr, 0);
+            break;
+        case 'a':
+            nelem = strtoul(optarg, nullptr, 0);
+            break;
+        default:
+            usage(argv[0]);
+            std::cerr<<"\nUnknown argument: "<<char(opt)<<std::endl;
+            return 1;
+        }
+    }
+
+    if(count==0u) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bench("NTScalar", makeScalar(), count);
+    bench("NTNDArray", makeNDArray(nelem), count);
+
+    return 0;
+}
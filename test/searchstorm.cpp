@@ -0,0 +1,186 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Replay a storm of search requests against a local server,
+ * and report the rate at which replies are received.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+#include <epicsTime.h>
+#include <epicsGetopt.h>
+#include <osiSock.h>
+
+#include <pvxs/server.h>
+#include <pvxs/source.h>
+#include <pvxs/log.h>
+#include "evhelper.h"
+#include "pvaproto.h"
+
+namespace {
+using namespace pvxs;
+
+DEFINE_LOGGER(app, "searchstorm");
+
+// claims every name with our prefix
+struct StormSource : public server::Source
+{
+    virtual void onSearch(Search &search) override final
+    {
+        for(auto& op : search) {
+            if(strncmp(op.name(), "storm:", 6)==0)
+                op.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final {}
+};
+
+void usage(const char *argv0)
+{
+    std::cerr<<"Usage: "<<argv0<<" [-n <count>] [-p <npvs>] [-w <window>]\n"
+               "\n"
+               "  -n <count>  Number of search requests to send.  (default 100000)\n"
+               "  -p <npvs>   Number of distinct PV names.  (default 1000)\n"
+               "  -w <window> Maximum requests awaiting reply.  (default 64)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t count = 100000u, npvs = 1000u, window = 64u;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "hn:p:w:")) != -1) {
+        switch (opt) {
+        case 'h':               /* Print usage */
+            usage(argv[0]);
+            return 0;
+        case 'n':
+            count = strtoul(optarg, nullptr, 0);
+            break;
+        case 'p':
+            npvs = strtoul(optarg, nullptr, 0);
+            break;
+        case 'w':
+            window = strtoul(optarg, nullptr, 0);
+            break;
+        default:
+            usage(argv[0]);
+            std::cerr<<"\nUnknown argument: "<<char(opt)<<std::endl;
+            return 1;
+        }
+    }
+
+    if(npvs==0u || window==0u) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    logger_config_env();
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("storm", std::make_shared<StormSource>());
+    serv.start();
+
+    SockAddr dest(SockAddr::loopback(AF_INET, serv.config().udp_port));
+    SockAddr sender(SockAddr::loopback(AF_INET));
+
+    evsocket sock(AF_INET, SOCK_DGRAM, 0);
+    sock.bind(sender);
+
+    // pre-build one request for each name
+    std::vector<std::vector<uint8_t>> requests(npvs);
+    for(auto i : range(npvs)) {
+        auto& msg = requests[i];
+        msg.resize(128u);
+        VectorOutBuf M(true, msg);
+
+        M.skip(8); // placeholder for header
+        to_wire(M, uint32_t(i));
+        M.skip(4);
+        to_wire(M, SockAddr::any(AF_INET));
+        to_wire(M, uint16_t(sender.port()));
+        to_wire(M, Size{1});
+        to_wire(M, "tcp");
+        to_wire(M, uint16_t(1u));
+        to_wire(M, uint32_t(i));
+        to_wire(M, std::string(SB()<<"storm:"<<i));
+
+        auto pktlen = M.save()-msg.data();
+
+        FixedBuf H(true, msg.data(), 8);
+        to_wire(H, Header{CMD_SEARCH, 0, uint32_t(pktlen-8)});
+
+        if(!M.good() || !H.good()) {
+            std::cerr<<"Error encoding search request\n";
+            return 1;
+        }
+        msg.resize(pktlen);
+    }
+
+    constexpr size_t nBatch = 32u;
+    std::vector<evsocket::mmsg> tx(nBatch), rx(nBatch);
+    std::vector<uint8_t> rxbuf(nBatch*0x10000);
+
+    size_t nsent = 0u, nreply = 0u, nlost = 0u;
+
+    epicsTimeStamp start, end;
+    epicsTimeGetCurrent(&start);
+
+    while(nsent < count || nsent > nreply + nlost) {
+        // fill the window
+        size_t pending = nsent > nreply + nlost ? nsent - nreply - nlost : 0u;
+        size_t ntx = std::min(count - nsent, window - pending);
+        ntx = std::min(ntx, nBatch);
+        for(auto i : range(ntx)) {
+            auto& req = requests[(nsent + i)%npvs];
+            tx[i].addr = dest;
+            tx[i].buf = req.data();
+            tx[i].len = req.size();
+        }
+        for(size_t i=0u; i<ntx; ) {
+            int n = sock.sendmmsg(&tx[i], ntx-i);
+            if(n<0) {
+                // eg. EAGAIN.  Try again after receiving some replies
+                ntx = i;
+                break;
+            }
+            i += n;
+        }
+        nsent += ntx;
+
+        // wait for replies
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(sock.sock, &fds);
+        timeval timo{1, 0};
+        if(select(int(sock.sock)+1, &fds, nullptr, nullptr, &timo)<=0) {
+            // assume outstanding requests, or replies, were dropped
+            nlost = nsent - nreply;
+            continue;
+        }
+
+        for(auto i : range(nBatch)) {
+            rx[i].buf = &rxbuf[i*0x10000];
+            rx[i].len = 0x10000;
+        }
+        int nrx = sock.recvmmsg(rx.data(), rx.size());
+        if(nrx>0)
+            nreply += size_t(nrx);
+    }
+
+    epicsTimeGetCurrent(&end);
+    double elapsed = epicsTimeDiffInSeconds(&end, &start);
+
+    std::cout<<"Sent "<<nsent<<" requests, received "<<nreply<<" replies ("<<nlost<<" lost) in "<<elapsed<<" sec.\n"
+             <<(nreply/elapsed)<<" replies/sec\n";
+
+    return 0;
+}
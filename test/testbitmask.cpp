@@ -84,6 +84,38 @@ void testBasic3()
     testEq(std::string(SB()<<M), "{63, 64, 67}");
 }
 
+void testLarge()
+{
+    testDiag("%s", __func__);
+
+    BitMask M({3, 200, 300, 511}, 600u);
+    testEq(M.size(), 600u);
+    testEq(M.wsize(), 10u);
+
+    testEq(M.findSet(4u), 200u);
+    testEq(M.findSet(201u), 300u);
+    testEq(M.findSet(301u), 511u);
+    testEq(M.findSet(512u), M.size());
+
+    testEq(std::string(SB()<<M), "{3, 200, 300, 511}");
+
+    // iteration stops at the end of the range, even when later bits are set
+    std::vector<size_t> bits;
+    for(auto bit : M.onlySet(0u, 250u))
+        bits.push_back(bit);
+    testEq(bits.size(), 2u);
+
+    bits.clear();
+    for(auto bit : M.onlySet(201u, 300u))
+        bits.push_back(bit);
+    testEq(bits.size(), 0u);
+
+    bits.clear();
+    for(auto bit : M.onlySet(300u, 301u))
+        bits.push_back(bit);
+    testEq(bits.size(), 1u);
+}
+
 void testOp()
 {
     testDiag("%s", __func__);
@@ -199,11 +231,12 @@ void testSer()
 
 MAIN(testbitmask)
 {
-    testPlan(76);
+    testPlan(86);
     testEmpty();
     testBasic1();
     testBasic2();
     testBasic3();
+    testLarge();
     testOp();
     testExpr();
     testSer();
@@ -44,13 +44,52 @@ void testParse()
     epicsEnvUnset("EPICS_PVA_BROADCAST_PORT");
 }
 
+void testParseServer()
+{
+    epicsEnvSet("EPICS_PVAS_TCP_WORKERS", "4");
+    epicsEnvSet("EPICS_PVAS_CALLBACK_WORKERS", "2");
+    epicsEnvSet("EPICS_PVAS_LARGE_REPLY_SIZE", "1024");
+
+    auto conf(server::Config::from_env());
+    testEq(conf.tcp_workers, 4u);
+    testEq(conf.callback_workers, 2u);
+    testEq(conf.large_reply_size, 1024u);
+
+    conf.tcp_workers = 0u;
+    conf.expand();
+    testOk(conf.tcp_workers!=0u, "expand() tcp_workers=%u", conf.tcp_workers);
+
+    epicsEnvUnset("EPICS_PVAS_TCP_WORKERS");
+    epicsEnvUnset("EPICS_PVAS_CALLBACK_WORKERS");
+    epicsEnvUnset("EPICS_PVAS_LARGE_REPLY_SIZE");
+}
+
+void testParseClient()
+{
+    epicsEnvSet("EPICS_PVA_TCP_WORKERS", "3");
+    epicsEnvSet("EPICS_PVA_CALLBACK_WORKERS", "2");
+
+    auto conf(client::Config::from_env());
+    testEq(conf.tcp_workers, 3u);
+    testEq(conf.callback_workers, 2u);
+
+    conf.tcp_workers = 0u;
+    conf.expand();
+    testOk(conf.tcp_workers!=0u, "expand() tcp_workers=%u", conf.tcp_workers);
+
+    epicsEnvUnset("EPICS_PVA_TCP_WORKERS");
+    epicsEnvUnset("EPICS_PVA_CALLBACK_WORKERS");
+}
+
 }
 
 MAIN(testconfig)
 {
-    testPlan(4);
+    testPlan(11);
     logger_config_env();
     testParse();
+    testParseServer();
+    testParseClient();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -4,9 +4,12 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <atomic>
+
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
+#include <epicsThread.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/data.h>
@@ -319,6 +322,51 @@ void testSerialize2()
     }
 }
 
+void testSerializeDelta()
+{
+    testDiag("%s", __func__);
+
+    auto base = TypeDef(TypeCode::Struct, {
+                            Member(TypeCode::UInt32, "a"),
+                            Member(TypeCode::Struct, "s", {
+                                Member(TypeCode::UInt32, "x"),
+                                Member(TypeCode::UInt32, "y"),
+                            }),
+                            Member(TypeCode::UInt32, "b"),
+                        }).create();
+
+    {
+        auto val = base.cloneEmpty();
+        auto delta = base.cloneEmpty();
+        val["a"] = 1u;
+        val["s.x"] = 2u;
+        val["s.y"] = 3u;
+        val["s"].mark();
+        delta["s.y"] = 4u;
+        delta["b"] = 5u;
+
+        // members of s sent individually
+        testToBytes(true, [&val, &delta](Buffer& buf) {
+            to_wire_valid(buf, val, delta);
+        }, "\x01\x3a\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x04\x00\x00\x00\x05");
+    }
+
+    {
+        auto val = base.cloneEmpty();
+        auto delta = base.cloneEmpty();
+        val["a"] = 1u;
+        val["s.x"] = 2u;
+        delta["s.x"] = 6u;
+        delta["s.y"] = 7u;
+        delta["s"].mark();
+
+        // all of s from delta
+        testToBytes(true, [&val, &delta](Buffer& buf) {
+            to_wire_valid(buf, val, delta);
+        }, "\x01\x06\x00\x00\x00\x01\x00\x00\x00\x06\x00\x00\x00\x07");
+    }
+}
+
 void testDeserialize2()
 {
     testDiag("%s", __func__);
@@ -447,6 +495,62 @@ void testTraverse()
     }
 }
 
+void testFieldRef()
+{
+    testDiag("%s", __func__);
+
+    auto proto = nt::NTScalar{TypeCode::Int32, true}.create();
+
+    FieldRef fsevr(proto, "alarm.severity");
+    FieldRef fvalue(proto, "value");
+    FieldRef fmissing(proto, "nonexistent");
+    FieldRef fsub(proto["alarm"], "status");
+
+    testOk1(fsevr.resolved());
+    testOk1(fvalue.resolved());
+    testOk1(!fmissing.resolved());
+    testOk1(fsub.resolved());
+    testEq(fsevr.name(), "alarm.severity");
+
+    auto val = proto.cloneEmpty();
+    val[fsevr] = 3;
+    val[fvalue] = 42;
+    val["alarm"][fsub] = 5;
+
+    testOk1(val[fsevr].compareInst(val["alarm.severity"]));
+    testOk1(val[fsevr].compareType(val["alarm.severity"]));
+    testEq(val["alarm.severity"].as<int32_t>(), 3);
+    testEq(val["alarm.status"].as<int32_t>(), 5);
+    testEq(val[fvalue].as<int32_t>(), 42);
+    testOk1(!!val["value"].isMarked());
+    testOk1(!val[fmissing].valid());
+    {
+        const Value cval(val);
+        testEq(cval[fvalue].as<int32_t>(), 42);
+    }
+
+    // another type, falls back to name lookup
+    auto other = nt::NTScalar{TypeCode::Float64}.create();
+    other[fvalue] = 1.5;
+    testEq(other["value"].as<double>(), 1.5);
+    testOk1(other[fsevr].compareInst(other["alarm.severity"]));
+
+    // not applicable to an invalid Value
+    testOk1(!Value()[fvalue].valid());
+
+    // paths through a Union are not resolved, but still work
+    auto uproto = TypeDef(TypeCode::Struct, {
+                              members::Union("u", {
+                                  members::Int32("a"),
+                              }),
+                          }).create();
+    FieldRef fa(uproto, "u->a");
+    testOk1(!fa.resolved());
+    auto uval = uproto.cloneEmpty();
+    uval[fa] = 7;
+    testEq(uval["u->a"].as<int32_t>(), 7);
+}
+
 void testAssign()
 {
     testDiag("%s", __func__);
@@ -465,6 +569,58 @@ void testAssign()
     testOk1(!val["alarm.status"].isMarked(true, true));
     testOk1(!!val["alarm"].isMarked(true, true));
     testOk1(!val["alarm"].isMarked(true, false));
+
+    // a marked sub-struct copies all of its fields
+    val["timeStamp.secondsPastEpoch"] = 1;
+    val["timeStamp.nanoseconds"] = 2;
+    val["timeStamp.userTag"] = 3;
+    val["timeStamp"].unmark();
+    val["timeStamp"].mark();
+
+    val2.assign(val);
+
+    testEq(val2["timeStamp.secondsPastEpoch"].as<int64_t>(), 1);
+    testEq(val2["timeStamp.nanoseconds"].as<int32_t>(), 2);
+    testEq(val2["timeStamp.userTag"].as<int32_t>(), 3);
+}
+
+void testUnmarkUnchanged()
+{
+    testDiag("%s", __func__);
+
+    auto def = nt::NTScalar{TypeCode::Float64A, true}.build();
+    auto prev = def.create();
+
+    shared_array<double> arr({1.0, 2.0});
+    prev["value"] = arr.freeze().castTo<const void>();
+    prev["alarm.severity"] = 1;
+    prev["display.units"] = "V";
+
+    // re-post of the whole structure, with one change
+    auto val = prev.clone();
+    val.mark();
+    val["alarm.severity"] = 2;
+
+    testOk1(val.unmarkUnchanged(prev));
+    testOk1(!val.isMarked(false, false));
+    testOk1(!!val["alarm.severity"].isMarked(false));
+    testOk1(!val["alarm.status"].isMarked(true));
+    testOk1(!val["value"].isMarked(true));
+    testOk1(!val["display.units"].isMarked(true));
+
+    // equal array contents, but not the same reference
+    auto val2 = prev.cloneEmpty();
+    shared_array<double> arr2({1.0, 2.0});
+    val2["value"] = arr2.freeze().castTo<const void>();
+
+    testOk1(val2.unmarkUnchanged(prev));
+    testOk1(!!val2["value"].isMarked());
+    testOk1(!val2.unmarkUnchanged(prev, true));
+    testOk1(!val2["value"].isMarked());
+
+    testThrows<std::runtime_error>([&val]() {
+        val.unmarkUnchanged(TypeDef(TypeCode::Struct, {}).create());
+    });
 }
 
 void testName()
@@ -529,6 +685,128 @@ void testIter()
     val["timeStamp"].mark();
 
     testMarked(6u)<<"mark sub-struct";
+
+    val.unmark();
+    val["timeStamp.userTag"].mark();
+
+    i=0;
+    auto alarm(val["alarm"]);
+    for(auto fld : alarm.imarked()) {
+        testDiag("field %s", alarm.nameOf(fld).c_str());
+        i++;
+    }
+    testEq(i, 0u)<<"sibling of marked sub-struct";
+
+    i=0;
+    auto ts(val["timeStamp"]);
+    for(auto fld : ts.imarked()) {
+        testEq(ts.nameOf(fld), "userTag");
+        i++;
+    }
+    testEq(i, 1u)<<"marked member of sub-struct";
+}
+
+// mark and unmark different fields, which share a word of mark bits, from two threads
+struct MarkWorker : public epicsThreadRunable
+{
+    Value fld;
+    const std::atomic<bool>& go;
+    unsigned nfail = 0u;
+    epicsThread worker;
+
+    MarkWorker(const Value& fld, const std::atomic<bool>& go)
+        :fld(fld)
+        ,go(go)
+        ,worker(*this, "marker", epicsThreadGetStackSize(epicsThreadStackSmall))
+    {}
+
+    virtual void run() override final
+    {
+        while(!go.load()) {}
+
+        for(auto i : range(1000000u)) {
+            (void)i;
+            fld.mark();
+            if(!fld.isMarked())
+                nfail++;
+            fld.unmark();
+            if(fld.isMarked())
+                nfail++;
+        }
+    }
+};
+
+void testMarkConcurrent()
+{
+    testDiag("%s", __func__);
+
+    auto val = TypeDef(TypeCode::Struct, {
+                           Member(TypeCode::UInt32, "a"),
+                           Member(TypeCode::UInt32, "b"),
+                       }).create();
+
+    std::atomic<bool> go{false};
+    MarkWorker A(val["a"], go), B(val["b"], go);
+    A.worker.start();
+    B.worker.start();
+    go = true;
+    A.worker.exitWait();
+    B.worker.exitWait();
+
+    testEq(A.nfail, 0u);
+    testEq(B.nfail, 0u);
+}
+
+void testMarkedMany()
+{
+    testDiag("%s", __func__);
+
+    // more than 255 fields
+    auto def = TypeDef(TypeCode::Struct, {});
+    for(auto i : range(300u))
+        def += {Member(TypeCode::UInt32, SB()<<"f"<<i)};
+
+    auto val = def.create();
+    val["f0"] = 1u;
+    val["f299"] = 299u;
+
+    testOk1(!!val["f299"].isMarked());
+    testOk1(!val["f298"].isMarked());
+
+    std::vector<uint8_t> buf;
+    {
+        VectorOutBuf S(true, buf);
+        to_wire_valid(S, val);
+        testOk1(S.good());
+        buf.resize(buf.size()-S.size());
+    }
+
+    {
+        TypeStore ctxt;
+        auto out = def.create();
+        FixedBuf S(true, buf);
+        from_wire_valid(S, ctxt, out);
+        testOk1(S.good() && S.empty());
+        testEq(out["f0"].as<uint32_t>(), 1u);
+        testEq(out["f299"].as<uint32_t>(), 299u);
+        testOk1(!out["f1"].isMarked());
+        testOk1(!!out["f299"].isMarked());
+    }
+
+    // a marked sub-struct and its member are sent once
+    {
+        auto val = TypeDef(TypeCode::Struct, {
+                               Member(TypeCode::Struct, "sub", {
+                                   Member(TypeCode::UInt32, "x"),
+                               }),
+                           }).create();
+        val["sub.x"] = 0x2a;
+        val["sub"].mark();
+
+        testToBytes(true, [&val](Buffer& buf) {
+            to_wire_valid(buf, val);
+        }, "\x01\x06\x00\x00\x00\x2a");
+    }
 }
 
 void testPvRequest()
@@ -583,17 +861,22 @@ void testPvRequest()
 
 MAIN(testdata)
 {
-    testPlan(82);
+    testPlan(130);
     testSerialize1();
     testDeserialize1();
     testSimpleDef();
     testSerialize2();
+    testSerializeDelta();
     testDeserialize2();
     testDeserialize3();
     testTraverse();
+    testFieldRef();
     testAssign();
+    testUnmarkUnchanged();
     testName();
     testIter();
+    testMarkedMany();
+    testMarkConcurrent();
     testPvRequest();
     cleanup_for_valgrind();
     return testDone();
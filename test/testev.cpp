@@ -4,9 +4,14 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <chrono>
+#include <vector>
+
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -64,6 +69,88 @@ void test_call()
 
 }
 
+// order is preserved even when more work is queued than fits in the ring
+void test_dispatch_order()
+{
+    testDiag("%s", __func__);
+
+    evbase base("TEST");
+
+    epicsEvent blocked, unblock;
+    base.dispatch([&blocked, &unblock]() {
+        blocked.trigger();
+        unblock.wait();
+    });
+    blocked.wait();
+
+    std::vector<size_t> order;
+    for(auto i : range(3000u)) {
+        base.dispatch([&order, i]() {
+            order.push_back(i);
+        });
+    }
+    unblock.trigger();
+    base.sync();
+
+    testEq(order.size(), 3000u);
+    bool match = true;
+    for(auto i : range(order.size())) {
+        if(order[i]!=i) {
+            testDiag("order[%u] == %u", unsigned(i), unsigned(order[i]));
+            match = false;
+            break;
+        }
+    }
+    testOk(match, "in order");
+}
+
+struct Producer : public epicsThreadRunable {
+    evbase& base;
+    size_t& count;
+    const size_t n;
+    epicsThread worker;
+    Producer(evbase& base, size_t& count, size_t n)
+        :base(base), count(count), n(n)
+        ,worker(*this, "producer", epicsThreadGetStackSize(epicsThreadStackSmall))
+    {}
+    virtual void run() override final {
+        auto pcount = &count;
+        for(auto i : range(n)) {
+            (void)i;
+            base.dispatch([pcount]() {
+                (*pcount)++; // only touched from loop worker
+            });
+        }
+    }
+};
+
+// not a real benchmark, but an indication of dispatch() throughput
+void test_dispatch_rate(size_t nthreads)
+{
+    testDiag("%s(%u)", __func__, unsigned(nthreads));
+
+    evbase base("TEST");
+    const size_t total = 200000u;
+    size_t count = 0u;
+
+    std::vector<std::unique_ptr<Producer>> producers;
+    for(auto i : range(nthreads)) {
+        (void)i;
+        producers.emplace_back(new Producer(base, count, total/nthreads));
+    }
+
+    auto start(std::chrono::steady_clock::now());
+    for(auto& prod : producers)
+        prod->worker.start();
+    for(auto& prod : producers)
+        prod->worker.exitWait();
+    base.sync();
+    std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+
+    testEq(count, total/nthreads*nthreads);
+    testDiag("%u producers -> %.0f dispatch/s", unsigned(nthreads), count/elapsed.count());
+}
+
 void test_fill_evbuf()
 {
     testDiag("%s", __func__);
@@ -108,13 +195,103 @@ void test_fill_evbuf()
     testEq(evbuffer_get_length(buf.get()), 0u);
 }
 
+void test_array_evbuf(bool be)
+{
+    testDiag("%s(%c)", __func__, be ? 'B' : 'L');
+
+    evbuf buf(evbuffer_new());
+
+    // spread over many small chunks so array copies must span them
+    for(uint32_t i : range(1024)) {
+        evbuf chunk(evbuffer_new());
+        {
+            EvOutBuf M(be, chunk.get());
+            to_wire(M, uint16_t(i*0x10001u));
+            to_wire(M, uint16_t((i*0x10001u)>>16u));
+            if(!M.good())
+                testAbort("EvOutBuf fault");
+        }
+        evbuffer_add_buffer(buf.get(), chunk.get());
+    }
+    testEq(evbuffer_get_length(buf.get()), 4*1024u);
+
+    {
+        // prepend one byte to misalign
+        uint8_t lead = 0x42;
+        evbuffer_prepend(buf.get(), &lead, 1);
+    }
+
+    {
+        EvInBuf M(be, buf.get());
+
+        uint8_t lead = 0;
+        from_wire(M, lead);
+        testEq(lead, 0x42);
+
+        std::vector<uint16_t> actual(2*1024u);
+        _from_wire_array<2>(M, reinterpret_cast<uint8_t*>(actual.data()), actual.size(), M.be ^ hostBE);
+        testOk1(!!M.good());
+
+        bool match = true;
+        for(uint32_t i : range(1024)) {
+            uint16_t lo = i*0x10001u, hi = (i*0x10001u)>>16u;
+            if(actual[2*i]!=lo || actual[2*i+1]!=hi) {
+                testDiag("%04x%04x == %04x%04x", hi, lo, actual[2*i+1], actual[2*i]);
+                match = false;
+                break; // only show first failure
+            }
+        }
+        testOk1(!!match);
+
+        uint32_t junk;
+        _from_wire_array<4>(M, reinterpret_cast<uint8_t*>(&junk), 1, false);
+        testOk1(!M.good()); // no more data
+    }
+}
+
+
+template<unsigned N>
+void test_swap_array()
+{
+    testDiag("%s<%u>", __func__, N);
+
+    // odd count to exercise both vector and scalar loops
+    constexpr size_t count = 67u;
+    std::vector<uint8_t> in(count*N), out(count*N);
+    for(auto i : range(in.size()))
+        in[i] = uint8_t(i);
+
+    _swap_array<N>(out.data(), in.data(), count);
+
+    bool match = true;
+    for(size_t i=0; i<count && match; i++) {
+        for(unsigned j=0; j<N; j++) {
+            if(out[i*N+j]!=in[i*N+N-1-j]) {
+                testDiag("element %u byte %u %02x != %02x", unsigned(i), j, out[i*N+j], in[i*N+N-1-j]);
+                match = false;
+                break;
+            }
+        }
+    }
+    testOk(match, "swapped %u elements", unsigned(count));
+}
+
 } // namespace
 
 MAIN(testev)
 {
-    testPlan(14);
+    testPlan(32);
     test_call();
+    test_dispatch_order();
+    test_dispatch_rate(1u);
+    test_dispatch_rate(4u);
+    test_dispatch_rate(16u);
     test_fill_evbuf();
+    test_array_evbuf(true);
+    test_array_evbuf(false);
+    test_swap_array<2>();
+    test_swap_array<4>();
+    test_swap_array<8>();
     libevent_global_shutdown();
     cleanup_for_valgrind();
     return testDone();
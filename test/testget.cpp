@@ -11,6 +11,7 @@
 #include <epicsUnitTest.h>
 
 #include <epicsEvent.h>
+#include <epicsThread.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -43,7 +44,7 @@ struct Tester {
         initial["value"] = 42;
     }
 
-    void testWait()
+    void testWait(int32_t expect = 42)
     {
         client::Result actual;
         epicsEvent done;
@@ -58,7 +59,7 @@ struct Tester {
         cli.hurryUp();
 
         if(testOk1(done.wait(5.0))) {
-            testEq(actual()["value"].as<int32_t>(), 42);
+            testEq(actual()["value"].as<int32_t>(), expect);
         } else {
             testSkip(1, "timeout");
         }
@@ -74,6 +75,66 @@ struct Tester {
         testWait();
     }
 
+    void repost()
+    {
+        testShow()<<__func__;
+
+        mbox.open(initial);
+        serv.start();
+
+        testWait();
+        testWait();
+
+        testDiag("GET after post() sees new value");
+        auto update(initial.cloneEmpty());
+        update["value"] = 43;
+        mbox.post(std::move(update));
+
+        testWait(43);
+    }
+
+    void bigArray()
+    {
+        testShow()<<__func__;
+
+        // much larger than one read
+        shared_array<double> arr(0x40000);
+        for(size_t i=0; i<arr.size(); i++)
+            arr[i] = i;
+
+        auto big(nt::NTScalar{TypeCode::Float64A}.create());
+        big["value"] = arr.freeze().castTo<const void>();
+
+        mbox.open(big);
+        serv.start();
+
+        client::Result actual;
+        epicsEvent done;
+
+        auto op = cli.get("mailbox")
+                .result([&actual, &done](client::Result&& result) {
+                    actual = std::move(result);
+                    done.trigger();
+                })
+                .exec();
+
+        cli.hurryUp();
+
+        if(testOk1(done.wait(5.0))) {
+            auto val(actual()["value"].as<shared_array<const void>>().castTo<const double>());
+            bool match = val.size()==0x40000u;
+            for(size_t i=0; i<val.size(); i++) {
+                if(val[i]!=i) {
+                    match = false;
+                    break;
+                }
+            }
+            testOk(match, "value[%u] round trip", unsigned(val.size()));
+        } else {
+            testSkip(1, "timeout");
+        }
+    }
+
     void lazy()
     {
         testShow()<<__func__;
@@ -213,18 +274,355 @@ void testError(bool phase)
     }
 }
 
+struct CountingSource : public server::Source
+{
+    const bool listed;
+    std::atomic<unsigned> nsearch{0u};
+
+    explicit CountingSource(bool listed) :listed(listed) {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        nsearch++;
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final {}
+    virtual List onList() override final
+    {
+        List ret{};
+        if(listed) {
+            auto names(std::make_shared<std::set<std::string>>());
+            names->insert("counted");
+            ret.names = names;
+        }
+        return ret;
+    }
+};
+
+void testSearchIndex()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto listed(std::make_shared<CountingSource>(true));
+    auto unlisted(std::make_shared<CountingSource>(false));
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addPV("mailbox", mbox)
+            .addSource("listed", listed)
+            .addSource("unlisted", unlisted)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    auto get = [&cli](const char *name, double timeout) -> bool {
+        epicsEvent done;
+        auto op = cli.get(name)
+                .result([&done](client::Result&& result) {
+                    done.trigger();
+                })
+                .exec();
+        cli.hurryUp();
+        return done.wait(timeout);
+    };
+
+    testOk1(get("mailbox", 5.0));
+    testOk1(listed->nsearch>0u);
+
+    testDiag("Search for a name no static Source lists");
+    listed->nsearch = 0u;
+    unlisted->nsearch = 0u;
+    testOk1(!get("nonexistent", 2.0));
+    // may add to its list without notice, so can not be indexed
+    testOk1(listed->nsearch>0u);
+    testOk1(unlisted->nsearch>0u);
+
+    testDiag("Add PV after search index is built");
+    auto late(server::SharedPV::buildReadonly());
+    late.open(initial);
+    serv.addPV("late", late);
+    testOk1(get("late", 5.0));
+}
+
+void testStaticBatch()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto pv1(server::SharedPV::buildReadonly());
+    auto pv2(server::SharedPV::buildReadonly());
+    pv1.open(initial);
+    pv2.open(initial);
+
+    auto src(server::StaticSource::build());
+    src.add({{"one", pv1}, {"two", pv2}});
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("batch", src.source())
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    auto get = [&cli](const char *name, double timeout) -> bool {
+        epicsEvent done;
+        bool ok = false;
+        auto op = cli.get(name)
+                .result([&done, &ok](client::Result&& result) {
+                    try {
+                        result();
+                        ok = true;
+                    } catch(std::exception&) {
+                    }
+                    done.trigger();
+                })
+                .exec();
+        cli.hurryUp();
+        return done.wait(timeout) && ok;
+    };
+
+    testOk1(get("one", 5.0));
+    testOk1(get("two", 5.0));
+
+    testDiag("Batch add with one duplicate adds nothing");
+    testThrows<std::logic_error>([&src, &pv1]() {
+        src.add({{"one", pv1}, {"three", pv1}});
+    });
+    testOk1(!get("three", 2.0));
+
+    testDiag("Batch remove");
+    src.remove(std::vector<std::string>{"one", "two", "nonexistent"});
+    testOk1(!pv1.isOpen());
+    testOk1(!get("two", 2.0));
+}
+
+void testCallbackWorkers()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    epicsEvent started, release;
+
+    auto slow(server::SharedPV::buildReadonly());
+    slow.onRPC([&started, &release](server::SharedPV& pv, std::unique_ptr<server::ExecOp>&& op, Value&& arg) {
+        started.signal();
+        release.wait(10.0);
+        op->reply(arg);
+    });
+    slow.open(initial);
+
+    auto fast(server::SharedPV::buildReadonly());
+    fast.open(initial);
+
+    auto conf(server::Config::isolated());
+    conf.callback_workers = 2u;
+
+    auto serv = conf.build()
+            .addPV("slow", slow)
+            .addPV("fast", fast)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    epicsEvent rpcDone;
+    auto rpc = cli.rpc("slow", initial.clone())
+            .result([&rpcDone](client::Result&& result) {
+                rpcDone.signal();
+            })
+            .exec();
+    cli.hurryUp();
+
+    testOk1(started.wait(5.0));
+
+    testDiag("GET while RPC handler is blocked");
+    epicsEvent getDone;
+    auto get = cli.get("fast")
+            .result([&getDone](client::Result&& result) {
+                getDone.signal();
+            })
+            .exec();
+    cli.hurryUp();
+
+    testOk1(getDone.wait(5.0));
+    testOk1(!rpcDone.tryWait());
+
+    release.signal();
+    testOk1(rpcDone.wait(5.0));
+}
+
+// installs onGet() only after connect()
+struct LateSource : public server::Source
+{
+    const Value type;
+    LateSource()
+        :type(nt::NTScalar{TypeCode::Int32}.create())
+    {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+
+        chan->onOp([this](std::unique_ptr<server::ConnectOp>&& op) {
+            op->connect(type);
+            // GET exec from the client arrives meanwhile
+            epicsThreadSleep(0.5);
+            op->onGet([this](std::unique_ptr<server::ExecOp>&& op) {
+                auto val(type.cloneEmpty());
+                val["value"] = 43;
+                op->reply(val);
+            });
+        });
+    }
+};
+
+void testLateHandler()
+{
+    testShow()<<__func__;
+
+    auto conf(server::Config::isolated());
+    conf.callback_workers = 2u;
+
+    auto serv = conf.build()
+            .addSource("late", std::make_shared<LateSource>())
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    client::Result actual;
+    epicsEvent done;
+
+    auto op = cli.get("late")
+            .result([&actual, &done](client::Result&& result) {
+                actual = std::move(result);
+                done.trigger();
+            })
+            .exec();
+
+    cli.hurryUp();
+
+    if(testOk1(done.wait(5.0))) {
+        testEq(actual()["value"].as<int32_t>(), 43);
+    } else {
+        testSkip(1, "timeout");
+    }
+}
+
+void testClientCallbackWorkers()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addPV("mailbox", mbox)
+            .start();
+
+    auto conf(serv.clientConfig());
+    conf.callback_workers = 2u;
+    auto cli = conf.build();
+
+    epicsEvent started, release, slowDone;
+    auto slow = cli.get("mailbox")
+            .result([&started, &release, &slowDone](client::Result&& result) {
+                started.signal();
+                release.wait(10.0);
+                slowDone.signal();
+            })
+            .exec();
+    cli.hurryUp();
+
+    testOk1(started.wait(5.0));
+
+    testDiag("GET while result() callback of another is blocked");
+    epicsEvent getDone;
+    auto get = cli.get("mailbox")
+            .result([&getDone](client::Result&& result) {
+                getDone.signal();
+            })
+            .exec();
+    cli.hurryUp();
+
+    testOk1(getDone.wait(5.0));
+
+    release.signal();
+    testOk1(slowDone.wait(5.0));
+}
+
+// With callback_workers==0, result() runs on the client TCP worker.  So the Context,
+// and the evbase of that worker, are destroyed from one of its own callbacks.
+void testCloseFromCallback(size_t callbackWorkers)
+{
+    testShow()<<__func__<<" callback_workers="<<callbackWorkers;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addPV("mailbox", mbox)
+            .start();
+
+    auto conf(serv.clientConfig());
+    conf.callback_workers = callbackWorkers;
+    auto cli = conf.build();
+    std::shared_ptr<client::Operation> get;
+    epicsEvent ready, done;
+
+    get = cli.get("mailbox")
+            .result([&cli, &get, &ready, &done](client::Result&& result) {
+                ready.wait(5.0);
+                testDiag("Release last references to Context and Operation from result()");
+                cli = client::Context();
+                get.reset();
+                done.signal();
+            })
+            .exec();
+    cli.hurryUp();
+    ready.signal();
+
+    testOk1(done.wait(5.0));
+}
+
 } // namespace
 
 MAIN(testget)
 {
-    testPlan(13);
+    testPlan(44);
     logger_config_env();
     Tester().loopback();
+    Tester().repost();
+    Tester().bigArray();
     Tester().lazy();
     Tester().timeout();
     Tester().cancel();
     testError(false);
     testError(true);
+    testSearchIndex();
+    testStaticBatch();
+    testCallbackWorkers();
+    testLateHandler();
+    testClientCallbackWorkers();
+    testCloseFromCallback(0u);
+    testCloseFromCallback(2u);
     cleanup_for_valgrind();
     return testDone();
 }
@@ -5,12 +5,17 @@
  */
 
 #include <atomic>
+#include <map>
+#include <vector>
 
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
 
 #include <epicsEvent.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+#include <epicsThread.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -32,8 +37,8 @@ struct BasicTest {
     epicsEvent evt;
     std::shared_ptr<client::Subscription> sub;
 
-    BasicTest()
-        :initial(nt::NTScalar{TypeCode::Int32}.create())
+    explicit BasicTest(TypeCode code = TypeCode::Int32)
+        :initial(nt::NTScalar{code}.create())
         ,mbox(server::SharedPV::buildReadonly())
         ,serv(server::Config::isolated()
               .build()
@@ -43,7 +48,8 @@ struct BasicTest {
         testShow()<<"Server:\n"<<serv.config()
                   <<"Client:\n"<<cli.config();
 
-        initial["value"] = 42;
+        if(!code.isarray())
+            initial["value"] = 42;
     }
 
     void subscribe(const char *name)
@@ -187,6 +193,350 @@ struct TestLifeCycle : public BasicTest
             testFail("Missing data update");
         }
     }
+
+    void testFanout()
+    {
+        testShow()<<__func__;
+
+        // a second client shares updates (and their serialization) with the first
+        auto cli2(serv.clientConfig().build());
+        epicsEvent evt2;
+
+        auto sub2 = cli2.monitor("mailbox")
+                        .maskConnected(true)
+                        .maskDisconnected(false)
+                        .event([&evt2](client::Subscription& sub) {
+                            testDiag("Event %s", __func__);
+                            evt2.trigger();
+                        })
+                        .exec();
+        cli2.hurryUp();
+
+        auto pop2 = [&sub2, &evt2](int32_t expect) {
+            Value val;
+            while(!(val = sub2->pop())) {
+                if(!evt2.wait(5.0))
+                    break;
+            }
+            if(val)
+                testEq(val["value"].as<int32_t>(), expect);
+            else
+                testFail("Missing data update %d on second client", int(expect));
+        };
+
+        pop2(42);
+
+        phase1();
+
+        pop2(123);
+
+        phase2(false);
+    }
+
+    void testSquash()
+    {
+        testShow()<<__func__;
+
+        testDiag("Wait for Data update event");
+        testOk1(!!evt.wait(5.0));
+        if(auto val = sub->pop()) {
+            testEq(val["value"].as<int32_t>(), 42);
+        } else {
+            testFail("Missing data update");
+        }
+
+        // post faster than updates can be sent.  Some will be squashed together,
+        // but no change may be lost.
+        {
+            auto update(initial.cloneEmpty());
+            update["value"] = 0;
+            update["alarm.severity"] = 2;
+            mbox.post(std::move(update));
+        }
+        for(int32_t i=1; i<1000; i++)
+            post(i);
+
+        bool sawSevr = false;
+        int32_t last = -1;
+        unsigned nupdate = 0u;
+        while(last!=999) {
+            if(auto val = sub->pop()) {
+                nupdate++;
+                if(val["alarm.severity"].as<int32_t>()==2)
+                    sawSevr = true;
+                last = val["value"].as<int32_t>();
+            } else if(!evt.wait(5.0)) {
+                break;
+            }
+        }
+        testDiag("Received %u updates", nupdate);
+        testEq(last, 999);
+        testOk1(sawSevr);
+    }
+
+    void testSquashNoRecycle()
+    {
+        testShow()<<__func__;
+
+        testDiag("Wait for Data update event");
+        testOk1(!!evt.wait(5.0));
+        (void)sub->pop();
+
+        // overfill the client queue, which squashes later updates.
+        for(int32_t i=1; i<=10; i++) {
+            auto update(initial.cloneEmpty());
+            update["value"] = i;
+            update["alarm.severity"] = 2;
+            mbox.post(std::move(update));
+            epicsThreadSleep(0.05);
+        }
+
+        int32_t last = -1;
+        while(last!=10) {
+            if(auto val = sub->pop()) {
+                last = val["value"].as<int32_t>();
+            } else if(!evt.wait(5.0)) {
+                break;
+            }
+        }
+        testEq(last, 10);
+
+        testDiag("Without recycle(), fields not in an update have default values");
+        post(200);
+
+        Value val;
+        while(!(val = sub->pop())) {
+            if(!evt.wait(5.0))
+                break;
+        }
+        if(val) {
+            testEq(val["value"].as<int32_t>(), 200);
+            testEq(val["alarm.severity"].as<int32_t>(), 0);
+        } else {
+            testFail("Missing data update");
+        }
+    }
+};
+
+struct TestFilter : public BasicTest
+{
+    TestFilter()
+    {
+        serv.start();
+        mbox.open(initial);
+    }
+
+    void subscribe(const std::string& opt, double val, uint32_t queueSize=0u)
+    {
+        sub = cli.monitor("mailbox")
+                .maskConnected(true)
+                .maskDisconnected(true)
+                .record(opt, val)
+                .record("queueSize", queueSize)
+                .event([this](client::Subscription& sub) {
+                    testDiag("Event %s", __func__);
+                    evt.trigger();
+                })
+                .exec();
+        cli.hurryUp();
+    }
+
+    Value pop()
+    {
+        Value ret;
+        while(!(ret = sub->pop())) {
+            if(!evt.wait(5.0)) {
+                testFail("Missing data update");
+                break;
+            }
+        }
+        return ret;
+    }
+
+    void testDeadband()
+    {
+        testShow()<<__func__;
+
+        subscribe("deadband", 5.0);
+
+        testEq(pop()["value"].as<int32_t>(), 42);
+
+        // within deadband
+        post(44);
+        post(45);
+        post(48);
+        testEq(pop()["value"].as<int32_t>(), 48);
+
+        // within deadband, but another field changes
+        {
+            auto update(initial.cloneEmpty());
+            update["value"] = 50;
+            update["alarm.severity"] = 1;
+            mbox.post(std::move(update));
+        }
+        if(auto val = pop()) {
+            testEq(val["value"].as<int32_t>(), 50);
+            testEq(val["alarm.severity"].as<int32_t>(), 1);
+        }
+
+        post(53);
+        post(56);
+        testEq(pop()["value"].as<int32_t>(), 56);
+
+        testOk1(!sub->pop());
+    }
+
+    void testRate(uint32_t queueSize)
+    {
+        testShow()<<__func__<<" queueSize="<<queueSize;
+
+        subscribe("maxRate", 2.0, queueSize);
+
+        testEq(pop()["value"].as<int32_t>(), 42);
+
+        // updates during the holdoff period are squashed
+        for(int32_t i=1; i<=10; i++)
+            post(i);
+
+        int32_t last = -1;
+        unsigned nupdate = 0u;
+        while(last!=10) {
+            if(auto val = pop()) {
+                nupdate++;
+                last = val["value"].as<int32_t>();
+            } else {
+                break;
+            }
+        }
+        testDiag("Received %u updates", nupdate);
+        testEq(last, 10);
+        testOk(nupdate<=2u, "nupdate=%u", nupdate);
+    }
+};
+
+struct TestRecycle : public BasicTest
+{
+    TestRecycle()
+        :BasicTest(TypeCode::UInt64A)
+    {
+        shared_array<uint64_t> arr({1u, 2u, 3u, 4u});
+        initial["value"] = arr.freeze().castTo<const void>();
+        serv.start();
+        mbox.open(initial);
+
+        sub = cli.monitor("mailbox")
+                .maskConnected(true)
+                .maskDisconnected(true)
+                .event([this](client::Subscription& sub) {
+                    evt.trigger();
+                })
+                .exec();
+        cli.hurryUp();
+    }
+
+    Value pop()
+    {
+        Value ret;
+        while(!(ret = sub->pop())) {
+            if(!evt.wait(5.0)) {
+                testFail("Missing data update");
+                break;
+            }
+        }
+        return ret;
+    }
+
+    void post(std::initializer_list<uint64_t> vals)
+    {
+        shared_array<uint64_t> arr(vals);
+        auto update(initial.cloneEmpty());
+        update["value"] = arr.freeze().castTo<const void>();
+        mbox.post(std::move(update));
+    }
+
+    void testRecycle()
+    {
+        testShow()<<__func__;
+
+        auto val(pop());
+        const void* storage = val["value"].as<shared_array<const void>>().data();
+        testEq(val["value"].as<shared_array<const void>>().castTo<const uint64_t>()[3], 4u);
+
+        sub->recycle(std::move(val));
+        testOk1(!val);
+
+        post({5u, 6u, 7u, 8u});
+
+        val = pop();
+        auto arr(val["value"].as<shared_array<const void>>().castTo<const uint64_t>());
+        testEq(arr[3], 8u);
+        testOk(arr.data()==storage, "Array reused %p == %p", arr.data(), storage);
+
+        testDiag("Recycle while keeping a reference to the array");
+        sub->recycle(std::move(val));
+
+        post({9u, 10u, 11u, 12u});
+
+        auto update(pop());
+        testOk(update["value"].as<shared_array<const void>>().data()!=storage, "Array not reused");
+        testEq(arr[3], 8u);
+    }
+};
+
+struct TestChanges : public BasicTest
+{
+    TestChanges()
+    {
+        initial["alarm.severity"] = 1;
+        mbox.detectChanges();
+        serv.start();
+        mbox.open(initial);
+
+        sub = cli.monitor("mailbox")
+                .maskConnected(true)
+                .maskDisconnected(true)
+                .event([this](client::Subscription& sub) {
+                    evt.trigger();
+                })
+                .exec();
+        cli.hurryUp();
+    }
+
+    Value pop()
+    {
+        Value ret;
+        while(!(ret = sub->pop())) {
+            if(!evt.wait(5.0)) {
+                testFail("Missing data update");
+                break;
+            }
+        }
+        return ret;
+    }
+
+    void testChanges()
+    {
+        testShow()<<__func__;
+
+        testEq(pop()["value"].as<int32_t>(), 42);
+
+        testDiag("post() entire structure with one change");
+        auto update(initial.clone());
+        update.mark();
+        update["value"] = 43;
+        mbox.post(std::move(update));
+
+        auto val(pop());
+        testEq(val["value"].as<int32_t>(), 43);
+        testOk1(!!val["value"].isMarked());
+        testOk1(!val["alarm.severity"].isMarked());
+
+        testDiag("post() without change is not sent");
+        post(43);
+        post(44);
+
+        testEq(pop()["value"].as<int32_t>(), 44);
+    }
 };
 
 struct TestReconn : public BasicTest
@@ -251,16 +601,222 @@ struct TestReconn : public BasicTest
     }
 };
 
+// posts through MonitorControlOp, re-using one Value
+struct AliasSource : public server::Source
+{
+    const Value prototype;
+    epicsEvent subscribed;
+    std::unique_ptr<server::MonitorControlOp> sub;
+
+    AliasSource() :prototype(nt::NTScalar{TypeCode::Int32}.create()) {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+
+        chan->onSubscribe([this](std::unique_ptr<server::MonitorSetupOp>&& setup) {
+            sub = setup->connect(prototype);
+            subscribed.signal();
+        });
+    }
+};
+
+void testAlias()
+{
+    testShow()<<__func__;
+
+    auto src(std::make_shared<AliasSource>());
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("alias", src)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    epicsEvent evt;
+    auto sub = cli.monitor("alias")
+            .maskConnected(true)
+            .maskDisconnected(true)
+            .event([&evt](client::Subscription& sub) {
+                evt.trigger();
+            })
+            .exec();
+    cli.hurryUp();
+
+    testOk1(src->subscribed.wait(5.0));
+
+    Value val(src->prototype.cloneEmpty());
+    for(int32_t i : {1, 2}) {
+        testDiag("post() while keeping a reference");
+        val["value"] = i;
+        Value alias(val);
+        src->sub->post(std::move(alias));
+
+        Value update;
+        while(!(update = sub->pop())) {
+            if(!evt.wait(5.0))
+                break;
+        }
+        if(update)
+            testEq(update["value"].as<int32_t>(), i);
+        else
+            testFail("Missing data update %d", int(i));
+    }
+}
+
+// "big" and "small" subscriptions.  An RPC to either posts to both
+// from a server worker, so that both updates are sent in the same batch.
+struct OrderSource : public server::Source
+{
+    const Value bigType, smallType;
+    epicsMutex lock;
+    epicsEvent subscribed;
+    std::map<std::string, std::unique_ptr<server::MonitorControlOp>> subs;
+
+    OrderSource()
+        :bigType(nt::NTScalar{TypeCode::Float64A}.create())
+        ,smallType(nt::NTScalar{TypeCode::Int32}.create())
+    {}
+
+    void post()
+    {
+        auto big(bigType.cloneEmpty());
+        big["value"] = shared_array<const double>(0x40000, 1.0).castTo<const void>();
+        auto small(smallType.cloneEmpty());
+        small["value"] = 1;
+
+        epicsGuard<epicsMutex> G(lock);
+        subs["big"]->post(std::move(big));
+        subs["small"]->post(std::move(small));
+    }
+
+    size_t count()
+    {
+        epicsGuard<epicsMutex> G(lock);
+        return subs.size();
+    }
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+        std::string name(chan->name());
+
+        chan->onSubscribe([this, name](std::unique_ptr<server::MonitorSetupOp>&& setup) {
+            auto sub(setup->connect(name=="big" ? bigType : smallType));
+            {
+                epicsGuard<epicsMutex> G(lock);
+                subs[name] = std::move(sub);
+            }
+            subscribed.signal();
+        });
+        chan->onRPC([this](std::unique_ptr<server::ExecOp>&& op, Value&& arg) {
+            post();
+            op->reply();
+        });
+    }
+};
+
+void testLargeLast()
+{
+    testShow()<<__func__;
+
+    auto src(std::make_shared<OrderSource>());
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("order", src)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    epicsMutex lock;
+    epicsEvent evt;
+    std::vector<std::string> received;
+
+    auto subscribe = [&](const std::string& name) {
+        return cli.monitor(name)
+                .maskConnected(true)
+                .maskDisconnected(true)
+                .event([&lock, &evt, &received, name](client::Subscription& sub) {
+                    while(sub.pop()) {
+                        epicsGuard<epicsMutex> G(lock);
+                        received.push_back(name);
+                    }
+                    evt.trigger();
+                })
+                .exec();
+    };
+    auto big(subscribe("big"));
+    auto small(subscribe("small"));
+    cli.hurryUp();
+
+    auto waitFor = [&lock, &evt, &received](size_t n) -> bool {
+        while(true) {
+            {
+                epicsGuard<epicsMutex> G(lock);
+                if(received.size()>=n)
+                    return true;
+            }
+            if(!evt.wait(5.0))
+                return false;
+        }
+    };
+
+    while(src->count()<2u) {
+        if(!src->subscribed.wait(5.0))
+            break;
+    }
+    testEq(src->count(), 2u);
+
+    testDiag("Wait for both subscriptions to start");
+    src->post();
+    testOk1(waitFor(2u));
+
+    testDiag("post() large then small update from a server worker");
+    auto rpc(cli.rpc("order", src->smallType.cloneEmpty()).exec());
+    cli.hurryUp();
+    testOk1(waitFor(4u));
+
+    epicsGuard<epicsMutex> G(lock);
+    if(testEq(received.size(), 4u)) {
+        testEq(received[2], "small");
+        testEq(received[3], "big");
+    } else {
+        testSkip(2, "Missing updates");
+    }
+}
+
 } // namespace
 
 MAIN(testmon)
 {
-    testPlan(38);
+    testPlan(92);
     logger_config_env();
     TestLifeCycle().testBasic(true);
     TestLifeCycle().testBasic(false);
     TestLifeCycle().testSecond();
+    TestLifeCycle().testFanout();
+    TestLifeCycle().testSquash();
+    TestLifeCycle().testSquashNoRecycle();
+    TestFilter().testDeadband();
+    TestFilter().testRate(0u);
+    TestFilter().testRate(4u);
+    TestRecycle().testRecycle();
+    TestChanges().testChanges();
     TestReconn().testReconn();
+    testAlias();
+    testLargeLast();
     cleanup_for_valgrind();
     return testDone();
 }
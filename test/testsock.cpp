@@ -52,6 +52,50 @@ void test_udp()
     testEq(src, send_addr);
 }
 
+void test_udp_batch()
+{
+    testDiag("Enter %s", __func__);
+
+    evsocket A(AF_INET, SOCK_DGRAM, 0),
+             B(AF_INET, SOCK_DGRAM, 0);
+
+    SockAddr bind_addr(SockAddr::loopback(AF_INET));
+    A.bind(bind_addr);
+
+    SockAddr send_addr(SockAddr::loopback(AF_INET));
+    B.bind(send_addr);
+
+    uint8_t msg[] = {1, 2, 3, 4, 5, 6};
+    evsocket::mmsg tx[3];
+    for(size_t i=0; i<3; i++) {
+        tx[i].addr = bind_addr;
+        tx[i].buf = msg;
+        tx[i].len = 2u*(i+1u);
+    }
+
+    int ret = B.sendmmsg(tx, 3);
+    testEq(ret, 3);
+
+    epicsThreadSleep(0.1);
+
+    uint8_t rxbuf[4][8] = {};
+    evsocket::mmsg rx[4];
+    for(size_t i=0; i<4; i++) {
+        rx[i].buf = rxbuf[i];
+        rx[i].len = sizeof(rxbuf[i]);
+    }
+
+    ret = A.recvmmsg(rx, 4);
+    testEq(ret, 3);
+    for(size_t i=0; i<3 && i<size_t(ret); i++) {
+        testOk(rx[i].len==2u*(i+1u) && std::memcmp(rxbuf[i], msg, rx[i].len)==0 && rx[i].addr==send_addr,
+               "Recv'd %u bytes from %s", unsigned(rx[i].len), rx[i].addr.tostring().c_str());
+    }
+
+    ret = A.recvmmsg(rx, 4);
+    testEq(ret, -1)<<"nothing more to receive";
+}
+
 void test_local_mcast()
 {
     testDiag("Enter %s", __func__);
@@ -206,8 +250,9 @@ void test_to_wire()
 
 MAIN(testsock)
 {
-    testPlan(33);
+    testPlan(39);
     test_udp();
+    test_udp_batch();
     test_local_mcast();
     test_from_wire();
     test_to_wire();
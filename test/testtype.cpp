@@ -10,6 +10,7 @@
 
 #include <pvxs/unittest.h>
 #include <pvxs/data.h>
+#include <pvxs/nt.h>
 #include "utilpvt.h"
 #include "dataimpl.h"
 
@@ -289,14 +290,28 @@ R"out(
            "}\n")<<"Actual:\n"<<val;
 }
 
+// the ID of a Struct[] applies to its elements
+void testNTNDArray()
+{
+    testDiag("%s()", __func__);
+
+    auto val(nt::NTNDArray{}.create());
+
+    testEq(val.id(), "epics:nt/NTNDArray:1.0");
+    testEq(val["dimension"].type(), TypeCode::StructA);
+    testEq(val["dimension"].allocMember().id(), "dimension_t");
+    testEq(val["attribute"].allocMember().id(), "epics:nt/NTAttribute:1.0");
+}
+
 } // namespace
 
 MAIN(testtype)
 {
-    testPlan(23);
+    testPlan(27);
     showSize();
     testBasic();
     testTypeDef();
+    testNTNDArray();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -11,6 +11,7 @@
 #include <pvxs/unittest.h>
 #include "dataimpl.h"
 #include "pvaproto.h"
+#include "evhelper.h"
 
 namespace {
 using namespace pvxs;
@@ -63,7 +64,7 @@ void testDecode1()
     {
         auto it = cache.find(1);
         if(testOk1(it!=cache.end())) {
-            testEq(it->second.size(), 4u);
+            testEq(it->second->size(), 4u);
         }
     }
 
@@ -465,7 +466,7 @@ void testEmptyRequest()
     }
 
     if(testEq(registry.size(), 1u)) {
-        testEq(registry[2].size(), 1u);
+        testEq(registry[2]->size(), 1u);
     }
 
     std::vector<FieldDesc> descs2;
@@ -487,14 +488,266 @@ void testEmptyRequest()
            "[0] struct  parent=[0]  [0:1)\n")<<"\nActual descs2\n"<<descs2.data();
 }
 
+// repeated type descriptions are sent as cache references
+void testTypeCache()
+{
+    testDiag("%s", __func__);
+
+    auto type(TypeDef(TypeCode::Struct, "simple_t", {
+                          members::Float64("value"),
+                          members::Struct("alarm", "alarm_t", {
+                              members::Int32("severity"),
+                          }),
+                      }).create());
+
+    TxTypeStore txcache;
+    TypeStore rxcache;
+
+    std::vector<uint8_t> expect;
+    {
+        VectorOutBuf buf(true, expect);
+        to_wire(buf, Value::Helper::desc(type));
+        testOk1(buf.good());
+        expect.resize(expect.size()-buf.size());
+    }
+
+    for(auto i : range(2u)) {
+        std::vector<uint8_t> msg;
+        {
+            VectorOutBuf buf(true, msg);
+            to_wire(buf, Value::Helper::type(type), txcache);
+            testOk1(buf.good());
+            msg.resize(msg.size()-buf.size());
+        }
+
+        if(i==0u) {
+            testEq(msg.size(), expect.size()+3u);
+            testEq(msg[0], 0xfd);
+        } else {
+            testEq(msg.size(), 3u);
+            testEq(msg[0], 0xfe);
+        }
+
+        std::vector<FieldDesc> descs;
+        {
+            FixedBuf buf(true, msg);
+            from_wire(buf, descs, rxcache);
+            testOk1(buf.good());
+            testEq(buf.size(), 0u);
+        }
+
+        testEq(std::string(SB()<<descs.data()),
+               std::string(SB()<<Value::Helper::desc(type)));
+    }
+
+    testEq(txcache.size(), 1u);
+    testEq(rxcache.size(), 1u);
+}
+
+// identical types share a single FieldDesc tree
+void testTypeIntern()
+{
+    testDiag("%s", __func__);
+
+    auto def(TypeDef(TypeCode::Struct, "simple_t", {
+                         members::Float64("value"),
+                         members::Struct("alarm", "alarm_t", {
+                             members::Int32("severity"),
+                         }),
+                         members::Any("any"),
+                     }));
+    auto type(def.create());
+
+    testOk1(Value::Helper::desc(type)==Value::Helper::desc(def.create()));
+
+    auto other(TypeDef(TypeCode::Struct, "other_t", {
+                           members::Float64("value"),
+                           members::Struct("alarm", "alarm_t", {
+                               members::Int32("severity"),
+                           }),
+                           members::Any("any"),
+                       }).create());
+    testOk1(Value::Helper::desc(type)!=Value::Helper::desc(other));
+
+    type["any"].from(other);
+
+    std::vector<uint8_t> msg;
+    {
+        VectorOutBuf buf(true, msg);
+        TxTypeStore txcache;
+        to_wire(buf, Value::Helper::type(type), txcache);
+        to_wire_full(buf, type);
+        testOk1(buf.good());
+        msg.resize(msg.size()-buf.size());
+    }
+
+    // as if received by two different connections
+    for(auto i : range(2u)) {
+        (void)i;
+        TypeStore rxcache;
+        Value val;
+        {
+            FixedBuf buf(true, msg);
+            from_wire_type_value(buf, rxcache, val);
+            testOk1(buf.good());
+            testEq(buf.size(), 0u);
+        }
+
+        testOk1(Value::Helper::desc(val)==Value::Helper::desc(type));
+        testOk1(Value::Helper::desc(val["any"].as<Value>())==Value::Helper::desc(other));
+        if(testEq(rxcache.size(), 1u))
+            testOk1(rxcache.begin()->second.get()==Value::Helper::desc(type));
+    }
+}
+
+// large arrays may be appended to an evbuffer by reference
+void testXCodeLargeArray(bool be)
+{
+    testDiag("%s(%c)", __func__, be ? 'B' : 'L');
+
+    auto val(TypeDef(TypeCode::Struct, {
+                         members::UInt32A("value"),
+                     }).create());
+
+    {
+        shared_array<uint32_t> arr(0x4000u);
+        for(auto i : range(arr.size()))
+            arr[i] = uint32_t(i*0x01020304u);
+        val["value"] = arr.freeze().castTo<const void>();
+    }
+
+    std::vector<uint8_t> expect;
+    {
+        VectorOutBuf buf(be, expect);
+        to_wire_full(buf, val);
+        testOk1(buf.good());
+        expect.resize(expect.size()-buf.size());
+    }
+
+    evbuf ebuf(evbuffer_new());
+    {
+        EvOutBuf buf(be, ebuf.get());
+        to_wire_full(buf, val);
+        testOk1(buf.good());
+    }
+
+    std::vector<uint8_t> actual(evbuffer_get_length(ebuf.get()));
+    evbuffer_copyout(ebuf.get(), actual.data(), actual.size());
+
+    testEq(actual.size(), expect.size());
+    testOk1(actual==expect);
+
+    auto out(val.cloneEmpty());
+    {
+        EvInBuf buf(be, ebuf.get());
+        TypeStore cache;
+        from_wire_full(buf, cache, out);
+        testOk1(buf.good());
+    }
+    auto oarr(out["value"].as<shared_array<const void>>().castTo<const uint32_t>());
+    auto iarr(val["value"].as<shared_array<const void>>().castTo<const uint32_t>());
+    testOk1(oarr.size()==iarr.size() && std::equal(oarr.begin(), oarr.end(), iarr.begin()));
+}
+
+// unsigned values with the MSB set are not sign extended
+void testXCodeUnsigned()
+{
+    testDiag("%s", __func__);
+
+    auto val(TypeDef(TypeCode::Struct, {
+                         members::UInt8("a"),
+                         members::UInt16("b"),
+                         members::UInt32("c"),
+                     }).create());
+
+    std::vector<uint8_t> msg({0xc8, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xfe});
+    {
+        FixedBuf buf(true, msg);
+        TypeStore cache;
+        from_wire_full(buf, cache, val);
+        testOk1(buf.good());
+    }
+
+    testEq(val["a"].as<uint64_t>(), 0xc8u);
+    testEq(val["b"].as<uint64_t>(), 0xfffeu);
+    testEq(val["c"].as<uint64_t>(), 0xfffffffeu);
+}
+
+// runs of fixed width fields, broken by sub-structures and other fields
+void testXCodeFixed(bool be)
+{
+    testDiag("%s(%c)", __func__, be ? 'B' : 'L');
+
+    auto val(TypeDef(TypeCode::Struct, {
+                         members::UInt8("a"),
+                         members::Int8("b"),
+                         members::Struct("sub", {
+                             members::UInt16("c"),
+                             members::String("s"),
+                             members::Int32("d"),
+                         }),
+                         members::Bool("e"),
+                         members::Float32("f"),
+                     }).create());
+
+    val["a"] = 200u;
+    val["b"] = -5;
+    val["sub.c"] = 0xfffeu;
+    val["sub.s"] = "hi";
+    val["sub.d"] = -2;
+    val["e"] = true;
+    val["f"] = 1.5;
+
+    std::vector<uint8_t> out;
+    {
+        VectorOutBuf buf(be, out);
+        to_wire_full(buf, val);
+        testOk1(buf.good());
+        out.resize(out.size()-buf.size());
+    }
+
+    std::vector<uint8_t> expect;
+    if(be) {
+        uint8_t msg[] = "\xc8\xfb\xff\xfe\x02hi\xff\xff\xff\xfe\x01\x3f\xc0\x00\x00";
+        expect.assign(msg, msg+sizeof(msg)-1);
+    } else {
+        uint8_t msg[] = "\xc8\xfb\xfe\xff\x02hi\xfe\xff\xff\xff\x01\x00\x00\xc0\x3f";
+        expect.assign(msg, msg+sizeof(msg)-1);
+    }
+    testEq(out, expect);
+
+    auto dec(val.cloneEmpty());
+    {
+        FixedBuf buf(be, out);
+        TypeStore cache;
+        from_wire_full(buf, cache, dec);
+        testOk1(buf.good());
+    }
+
+    testEq(dec["a"].as<uint64_t>(), 200u);
+    testEq(dec["b"].as<int32_t>(), -5);
+    testEq(dec["sub.c"].as<uint64_t>(), 0xfffeu);
+    testEq(dec["sub.s"].as<std::string>(), "hi");
+    testEq(dec["sub.d"].as<int32_t>(), -2);
+    testEq(dec["e"].as<bool>(), true);
+    testEq(dec["f"].as<double>(), 1.5);
+}
+
 } // namespace
 
 MAIN(testxcode)
 {
-    testPlan(34);
+    testPlan(100);
     testDecode1();
     testXCodeNTScalar();
     testXCodeNTNDArray();
     testEmptyRequest();
+    testTypeCache();
+    testTypeIntern();
+    testXCodeLargeArray(true);
+    testXCodeLargeArray(false);
+    testXCodeUnsigned();
+    testXCodeFixed(true);
+    testXCodeFixed(false);
     return testDone();
 }